@@ -29,12 +29,9 @@ _init:
     ldx #$FF
     txs
     
-    ; Inicializar stack pointer de CC65 (software stack)
-    ; Usar $3DFF como tope del stack
-    lda #<$3DFF
-    sta sp
-    lda #>$3DFF
-    sta sp+1
+    ; Stack de CC65: se sigue usando el del monitor (sp en $0E,
+    ; include/romrt.s). El runtime está en ROM y comparte sus
+    ; variables ZP, así que no se reinicializa sp
     
     ; Inicializar BSS a ceros
     jsr zerobss
@@ -5,8 +5,13 @@
  * Los programas standalone pueden llamar estas funciones sin incluir
  * las librerias, ahorrando espacio en RAM.
  * 
- * JUMP TABLE: $BF00 - $BFED (38 funciones)
- * MAGIC:      $BF84 - "ROMAPI" v2.4
+ * JUMP TABLE: $BF00 - $BF83 (44 funciones)
+ * MAGIC:      $BF84 - "ROMAPI" v3.14
+ * FEATURES:   $BF8B - bitmap de 16 bits (ROMAPI_FEAT_*)
+ *             $BF8D - segundo bitmap de 8 bits (ROMAPI_FEAT2_*, v3.12+)
+ * EXTENDIDA:  $BF90 - ...     (funciones nuevas, v2.5+)
+ * V3:         $BE00 - ...     (todas con parmetros en ZP)
+ * RUNTIME:    $BD00 - $BDFF   (helpers de CC65, ver include/romrt.s)
  * 
  * 
  *   CONVENCIN DE LLAMADA (CC65):                         
@@ -66,9 +71,50 @@
  * $BF78     sd_is_ready()      fastcall
  * $BF7B     sd_get_type()      fastcall
  * $BF84     Magic "ROMAPI"     -         Identificador + version
+ * $BF90     mfs_list_ext       [ZP]      $F4=index(16b), $F6=info ptr
+ * $BF93     mfs_get_size32()   fastcall  retorna uint32
+ * $BF96     mfs_seek           mdulo    ranura STREAM+4
+ * $BF99     mfs_tell           mdulo    ranura STREAM+5
+ * $BF9C     spi_transfer_block mdulo    ranura SPIBLK
+ * $BF9F-$BFA8 stream open/getc/poll/close  mdulo  ranuras STREAM+0..3
+ * 
+ * --- Bloque v3 (parmetros solo en ZP/registros) ---
+ * Ninguna entrada lee parmetros del stack de CC65 del programa. Las
+ * marcadas "C" pasan por una funcin C de la ROM, que por dentro usa
+ * el stack de CC65 del monitor (sp en $0E), como los wrappers de $BF00.
+ * $BE00     mfs_read           [ZP] C    $F0=buf, $F2=len
+ * $BE03     mfs_list           [ZP] C    $F4=index(16b), $F6=info ptr
+ * $BE06     mfs_open           [ZP] C    $F4=name
+ * $BE09     mfs_seek           mdulo    ranura STREAM+4
+ * $BE0C     sd_read_sector     [ZP] C    $F0=sector(32b), $F4=buf
+ * $BE0F     sd_write_sector    [ZP] C    $F0=sector(32b), $F4=buf
+ * $BE12     spi_transfer_block mdulo    ranura SPIBLK
+ * $BE15-$BE1B mem_copy/fill/compare     mdulo  ranuras MEM+0..2
+ * $BE1E-$BE24 mul8x8/mul16x16/div32x16  mdulo  ranuras MULDIV+0..2
+ *             A*X -> A/X; $F0*$F2 -> $F4-$F7; $F0(32b)/$F4 -> $F0, resto $F4
+ * $BE27     bin_to_bcd         [ZP]      $F0=val(32b), $F4=buf (5 bytes)
+ * $BE2A     u16toa             [ZP]      $F0=val, $F4=buf, A=longitud
+ * $BE2D     u32toa             [ZP]      $F0=val(32b), $F4=buf, A=longitud
+ * $BE30     u16tohex           [ZP]      $F0=val, $F4=buf ("HHHH")
+ * $BE33     cmd_register       [ZP] C    $F0=nodo rom_ucmd_t (0=borrar)
+ * $BE36     lz_unpack          mdulo    ranura LZ
+ * $BE39-$BE4B arena/pools               mdulo  ranuras ALLOC+0..6
+ * $BE4E-$BE54 task_add/remove/yield     mdulo  ranuras TASK+0..2
+ * $BE57-$BE5A alarm_set/cancel          mdulo  ranuras ALARM+0..1
+ * $BE5D     spi_xfer_buf       mdulo    ranura BUSBLK (SPIBLK.X65)
+ * $BE60-$BE63 i2c_write_buf/read_buf      mdulo  ranuras BUSBLK+1..2
+ * $BE66     stats_read         -         A/X = rom_stats_t (contadores)
+ * $BE69     ext_register       [ZP]      $F0=rom_ext_t (0=todas a $FF)
+ * $BE6C     ext_features       -         retorna los bitmaps en vivo
+ * $BE6F     mfs_write          [ZP] C    $F4=buf, $F6=len (v3.14)
+ * $BE72     mfs_create         [ZP] C    $F4=name, $F6=size (v3.14)
+ *
+ * "mdulo": la ROM salta por un vector en RAM ($0200). Sin mdulo
+ * residente que lo instale (rom_ext_register) retorna $FF en A/X/sreg.
  * 
  * NOTA: i2c_write ($BF6C) e i2c_read ($BF6F) usan stack CC65.
  *       No tienen wrapper ZP. Desde programas externos, usar
+ *       i2c_write_buf/i2c_read_buf ($BE60/$BE63, mdulo I2CBLK) o
  *       las funciones byte-level: start/stop/write_byte/read_byte.
  */
 
@@ -103,6 +149,15 @@
 #define ROMAPI_MFS_WRITE        0xBF3F    /* [ZP] usa $F4-$F7 */
 #define ROMAPI_MFS_DELETE       0xBF42
 #define ROMAPI_MFS_FORMAT       0xBF45
+#define ROMAPI_MFS_LIST_EXT     0xBF90    /* [ZP] usa $F4-$F7 */
+#define ROMAPI_MFS_GET_SIZE32   0xBF93
+#define ROMAPI_MFS_SEEK         0xBF96    /* mdulo STREAM, usa $F0-$F3 */
+#define ROMAPI_MFS_TELL         0xBF99    /* mdulo STREAM */
+#define ROMAPI_SPI_XFER_BLOCK   0xBF9C    /* mdulo SPIBLK, usa $F0-$F3 */
+#define ROMAPI_MFS_STREAM_OPEN  0xBF9F    /* mdulo STREAM, usa $F4-$F7 */
+#define ROMAPI_MFS_STREAM_GETC  0xBFA2    /* mdulo STREAM */
+#define ROMAPI_MFS_STREAM_POLL  0xBFA5    /* mdulo STREAM */
+#define ROMAPI_MFS_STREAM_CLOSE 0xBFA8    /* mdulo STREAM */
 
 /* --- UART --- */
 #define ROMAPI_UART_INIT        0xBF15
@@ -143,6 +198,92 @@
 /* --- Identificador ROM API --- */
 #define ROMAPI_MAGIC_ADDR       0xBF84
 #define ROMAPI_MAGIC            "ROMAPI"
+#define ROMAPI_VERSION_ADDR     0xBF8A    /* major<<4 | minor */
+#define ROMAPI_FEATURES_ADDR    0xBF8B    /* uint16_t */
+#define ROMAPI_FEATURES2_ADDR   0xBF8D    /* uint8_t, desde v3.12 */
+
+/* Bits de ROMAPI_FEATURES_ADDR: lo que sirve la ROM sola. Los bits
+ * "mdulo" solo aparecen en rom_ext_features(), cuando un mdulo
+ * residente atiende esas ranuras */
+#define ROMAPI_FEAT_SEEK        0x0002    /* mdulo: seek/tell del stream */
+#define ROMAPI_FEAT_SPIBLK      0x0004    /* mdulo: spi_transfer_block, spi_xfer_buf */
+#define ROMAPI_FEAT_STREAM      0x0008    /* mdulo: streaming */
+#define ROMAPI_FEAT_V3          0x0010    /* bloque v3 en $BE00 (ZP) */
+#define ROMAPI_FEAT_MEM         0x0020    /* mdulo: mem_copy/fill/compare */
+#define ROMAPI_FEAT_MATH        0x0040    /* $BE27-$BE30 */
+#define ROMAPI_FEAT_RUNTIME     0x0080    /* $BD00, include/romrt.s */
+#define ROMAPI_FEAT_CMDREG      0x0100    /* $BE33 */
+#define ROMAPI_FEAT_EXEHDR      0x0200    /* cabecera X65 en $BF7E/$BF81 */
+#define ROMAPI_FEAT_LZ          0x0400    /* mdulo: lz_unpack */
+#define ROMAPI_FEAT_ALLOC       0x1000    /* mdulo: arena y pools */
+#define ROMAPI_FEAT_SCHED       0x2000    /* mdulo: tareas */
+#define ROMAPI_FEAT_ALARM       0x4000    /* mdulo: alarmas */
+#define ROMAPI_FEAT_BUSBLK      0x8000    /* mdulo: I2C en bloque */
+/* 0x0001 y 0x0800 sin asignar */
+
+/* Bits de ROMAPI_FEATURES2_ADDR */
+#define ROMAPI_FEAT2_STATS      0x01      /* $BE66 stats_read */
+#define ROMAPI_FEAT2_EXT        0x02      /* ranuras de extensin (v3.13) */
+#define ROMAPI_FEAT2_MULDIV     0x04      /* mdulo: mul/div */
+
+#define rom_version()           (*(volatile uint8_t*)ROMAPI_VERSION_ADDR)
+#define rom_has_feature(f)      (rom_version() >= 0x30 && \
+     (*(volatile uint16_t*)ROMAPI_FEATURES_ADDR & (f)))
+#define rom_has_feature2(f)     (rom_version() >= 0x3C && \
+     (*(volatile uint8_t*)ROMAPI_FEATURES2_ADDR & (f)))
+
+/* --- Bloque v3 (parmetros en ZP) --- */
+#define ROMAPI3_BASE            0xBE00
+#define ROMAPI3_MFS_READ        0xBE00    /* [ZP] usa $F0-$F3 */
+#define ROMAPI3_MFS_LIST        0xBE03    /* [ZP] usa $F4-$F7 */
+#define ROMAPI3_MFS_OPEN        0xBE06    /* [ZP] usa $F4-$F5 */
+#define ROMAPI3_SD_READ_SECTOR  0xBE0C    /* [ZP] usa $F0-$F5 */
+#define ROMAPI3_SD_WRITE_SECTOR 0xBE0F    /* [ZP] usa $F0-$F5 */
+#define ROMAPI3_MEM_COPY        0xBE15    /* mdulo MEM, usa $F0-$F5 */
+#define ROMAPI3_MEM_FILL        0xBE18    /* mdulo MEM, usa $F0-$F3 */
+#define ROMAPI3_MEM_COMPARE     0xBE1B    /* mdulo MEM, usa $F0-$F5 */
+#define ROMAPI3_MUL8X8          0xBE1E    /* mdulo MULDIV */
+#define ROMAPI3_MUL16X16        0xBE21    /* mdulo MULDIV, usa $F0-$F7 */
+#define ROMAPI3_DIV32X16        0xBE24    /* mdulo MULDIV, usa $F0-$F5 */
+#define ROMAPI3_BIN_TO_BCD      0xBE27    /* [ZP] usa $F0-$F5 */
+#define ROMAPI3_U16TOA          0xBE2A    /* [ZP] usa $F0-$F1, $F4-$F5 */
+#define ROMAPI3_U32TOA          0xBE2D    /* [ZP] usa $F0-$F5 */
+#define ROMAPI3_U16TOHEX        0xBE30    /* [ZP] usa $F0-$F1, $F4-$F5 */
+#define ROMAPI3_CMD_REGISTER    0xBE33    /* [ZP] usa $F0-$F1 */
+#define ROMAPI3_LZ_UNPACK       0xBE36    /* mdulo LZ, usa $F0-$F3 */
+#define ROMAPI3_ARENA_INIT      0xBE39    /* mdulo ALLOC, usa $F0-$F3 */
+#define ROMAPI3_ARENA_ALLOC     0xBE3C    /* mdulo ALLOC, usa $F0-$F7 */
+#define ROMAPI3_ARENA_MARK      0xBE3F    /* mdulo ALLOC, usa $F0-$F1 */
+#define ROMAPI3_ARENA_RELEASE   0xBE42    /* mdulo ALLOC, usa $F0-$F3 */
+#define ROMAPI3_POOL_INIT       0xBE45    /* mdulo ALLOC, usa $F0-$F7 */
+#define ROMAPI3_POOL_ALLOC      0xBE48    /* mdulo ALLOC, usa $F0-$F1 */
+#define ROMAPI3_POOL_FREE       0xBE4B    /* mdulo ALLOC, usa $F0-$F3 */
+#define ROMAPI3_TASK_ADD        0xBE4E    /* mdulo SCHED, usa $F0-$F1 */
+#define ROMAPI3_TASK_REMOVE     0xBE51    /* mdulo SCHED, usa $F0-$F1 */
+#define ROMAPI3_TASK_YIELD      0xBE54    /* mdulo SCHED */
+#define ROMAPI3_ALARM_SET       0xBE57    /* mdulo SCHED, usa $F0-$F5 */
+#define ROMAPI3_ALARM_CANCEL    0xBE5A    /* mdulo SCHED, usa $F0-$F1 */
+#define ROMAPI3_SPI_XFER_BUF    0xBE5D    /* mdulo SPIBLK, usa $F0-$F5 */
+#define ROMAPI3_I2C_WRITE_BUF   0xBE60    /* mdulo I2CBLK, usa $F0-$F7 */
+#define ROMAPI3_I2C_READ_BUF    0xBE63    /* mdulo I2CBLK, usa $F0-$F7 */
+#define ROMAPI3_STATS_READ      0xBE66
+#define ROMAPI3_EXT_REGISTER    0xBE69    /* [ZP] usa $F0-$F1 */
+#define ROMAPI3_EXT_FEATURES    0xBE6C
+#define ROMAPI3_MFS_WRITE       0xBE6F    /* [ZP] usa $F4-$F7, v3.14 */
+#define ROMAPI3_MFS_CREATE      0xBE72    /* [ZP] usa $F4-$F7, v3.14 */
+
+/* Ranuras de extensin: primera de cada familia (rom_ext_t.first) */
+#define ROMAPI_X_SPIBLK         0         /* spi_transfer_block */
+#define ROMAPI_X_BUSBLK         1         /* spi_xfer_buf, i2c_write_buf, i2c_read_buf */
+#define ROMAPI_X_STREAM         4         /* open, getc, poll, close, seek, tell */
+#define ROMAPI_X_MEM            10        /* mem_copy, mem_fill, mem_compare */
+#define ROMAPI_X_MULDIV         13        /* mul8x8, mul16x16, div32x16 */
+#define ROMAPI_X_LZ             16        /* lz_unpack */
+#define ROMAPI_X_ALLOC          17        /* arena x4, pool x3 */
+#define ROMAPI_X_TASK           24        /* task_add, task_remove, task_yield */
+#define ROMAPI_X_ALARM          27        /* alarm_set, alarm_cancel */
+#define ROMAPI_X_COUNT          29
+#define ROMAPI_EXT_VEC_ADDR     0x0200    /* vectores de las ranuras (RAM) */
 
 /* --- Carga y ejecución desde SD --- */
 #define ROMAPI_MFS_LOAD_FILE    0xBF7E
@@ -168,10 +309,15 @@
      ((uint8_t (*)(void))ROMAPI_MFS_OPEN)())
 #define rom_mfs_close()         (((void (*)(void))ROMAPI_MFS_CLOSE)())
 #define rom_mfs_get_size()      (((uint16_t (*)(void))ROMAPI_MFS_GET_SIZE)())
+#define rom_mfs_get_size32()    (((uint32_t (*)(void))ROMAPI_MFS_GET_SIZE32)())
 #define rom_mfs_delete(name)    \
     (*(volatile uint16_t*)0xF4 = (uint16_t)(name), \
      ((uint8_t (*)(void))ROMAPI_MFS_DELETE)())
 #define rom_mfs_format()        (((uint8_t (*)(void))ROMAPI_MFS_FORMAT)())
+#define rom_mfs_stream_getc()   (((int (*)(void))ROMAPI_MFS_STREAM_GETC)())
+#define rom_mfs_stream_poll()   (((void (*)(void))ROMAPI_MFS_STREAM_POLL)())
+#define rom_mfs_stream_close()  (((void (*)(void))ROMAPI_MFS_STREAM_CLOSE)())
+#define rom_mfs_tell()          (((uint32_t (*)(void))ROMAPI_MFS_TELL)())
 
 /* --- UART --- */
 #define rom_uart_init()         (((void (*)(void))ROMAPI_UART_INIT)())
@@ -253,6 +399,292 @@ typedef struct {
      *(volatile uint16_t*)0xF5 = (uint16_t)(info), \
      ((uint8_t (*)(void))ROMAPI_MFS_LIST)())
 
+/* mfs_list_ext:  $F4-$F5 = index (0..n-1),  $F6-$F7 = info ptr */
+/*   Lee del indice en RAM del monitor (no accede a la SD).       */
+/*   size es de 32 bits pero MicroFS no pasa de 16.               */
+/*   Retorna MFS_ERR_NOTFOUND al final, o MFS_ERR_PARTIAL si el   */
+/*   directorio tiene mas archivos que el indice.                 */
+typedef struct {
+    char     name[13];
+    uint32_t size;
+} rom_mfs_fileinfo32_t;
+
+#define rom_mfs_list_ext_via_zp(index, info) \
+    (*(volatile uint16_t*)0xF4 = (index), \
+     *(volatile uint16_t*)0xF6 = (uint16_t)(info), \
+     ((uint8_t (*)(void))ROMAPI_MFS_LIST_EXT)())
+
+/* Bloque v3: mismos parametros ZP; el stack de CC65 del programa no  */
+/*   se toca (la ROM usa el suyo). write/create desde v3.14 ($3E)     */
+#define rom3_mfs_read(buf, len) \
+    (*(volatile uint16_t*)0xF0 = (uint16_t)(buf), \
+     *(volatile uint16_t*)0xF2 = (len), \
+     ((uint16_t (*)(void))ROMAPI3_MFS_READ)())
+
+#define rom3_mfs_list(index, info) \
+    (*(volatile uint16_t*)0xF4 = (index), \
+     *(volatile uint16_t*)0xF6 = (uint16_t)(info), \
+     ((uint8_t (*)(void))ROMAPI3_MFS_LIST)())
+
+#define rom3_mfs_open(name) \
+    (*(volatile uint16_t*)0xF4 = (uint16_t)(name), \
+     ((uint8_t (*)(void))ROMAPI3_MFS_OPEN)())
+
+#define rom3_mfs_write(buf, len) \
+    (*(volatile uint16_t*)0xF4 = (uint16_t)(buf), \
+     *(volatile uint16_t*)0xF6 = (len), \
+     ((uint16_t (*)(void))ROMAPI3_MFS_WRITE)())
+
+#define rom3_mfs_create(name, size) \
+    (*(volatile uint16_t*)0xF4 = (uint16_t)(name), \
+     *(volatile uint16_t*)0xF6 = (size), \
+     ((uint8_t (*)(void))ROMAPI3_MFS_CREATE)())
+
+/* mem: ranuras MEM, las atiende modules/MEM.X65. copy admite          */
+/*   solapamiento; compare retorna 0, 1 (a > b) o -1 (a < b)           */
+#define rom_mem_copy(dst, src, len) \
+    (*(volatile uint16_t*)0xF0 = (uint16_t)(src), \
+     *(volatile uint16_t*)0xF2 = (uint16_t)(dst), \
+     *(volatile uint16_t*)0xF4 = (len), \
+     ((void (*)(void))ROMAPI3_MEM_COPY)())
+
+#define rom_mem_fill(dst, val, len) \
+    (*(volatile uint16_t*)0xF0 = (uint16_t)(dst), \
+     *(volatile uint16_t*)0xF2 = (len), \
+     ((void (*)(uint8_t))ROMAPI3_MEM_FILL)(val))
+
+#define rom_mem_compare(a, b, len) \
+    (*(volatile uint16_t*)0xF0 = (uint16_t)(a), \
+     *(volatile uint16_t*)0xF2 = (uint16_t)(b), \
+     *(volatile uint16_t*)0xF4 = (len), \
+     ((int (*)(void))ROMAPI3_MEM_COMPARE)())
+
+/* mul/div: ranuras MULDIV, las atiende modules/MULDIV.X65. Sin el     */
+/*   mdulo retornan $FF (comprobar ROMAPI_FEAT2_MULDIV en el sreg de  */
+/*   rom_ext_features())                                              */
+#define rom_mul8x8(a, b) \
+    (((uint16_t (*)(uint16_t))ROMAPI3_MUL8X8)((uint8_t)(a) | ((uint16_t)(b) << 8)))
+
+#define rom_mul16x16(a, b) \
+    (*(volatile uint16_t*)0xF0 = (a), \
+     *(volatile uint16_t*)0xF2 = (b), \
+     ((void (*)(void))ROMAPI3_MUL16X16)(), \
+     *(volatile uint32_t*)0xF4)
+
+/* Cociente de 32 bits; el resto queda en *(uint16_t*)0xF4 */
+#define rom_div32x16(n, d) \
+    (*(volatile uint32_t*)0xF0 = (n), \
+     *(volatile uint16_t*)0xF4 = (d), \
+     ((void (*)(void))ROMAPI3_DIV32X16)(), \
+     *(volatile uint32_t*)0xF0)
+#define rom_div_remainder()     (*(volatile uint16_t*)0xF4)
+
+/* Formato de numeros: sin la division generica de CC65                 */
+/*   buf de u16toa/u32toa: 6/11 bytes como minimo (con NUL)              */
+#define rom_bin_to_bcd(val, bcd) \
+    (*(volatile uint32_t*)0xF0 = (val), \
+     *(volatile uint16_t*)0xF4 = (uint16_t)(bcd), \
+     ((void (*)(void))ROMAPI3_BIN_TO_BCD)())
+
+#define rom_u16toa(val, buf) \
+    (*(volatile uint16_t*)0xF0 = (val), \
+     *(volatile uint16_t*)0xF4 = (uint16_t)(buf), \
+     ((uint8_t (*)(void))ROMAPI3_U16TOA)())
+
+#define rom_u32toa(val, buf) \
+    (*(volatile uint32_t*)0xF0 = (val), \
+     *(volatile uint16_t*)0xF4 = (uint16_t)(buf), \
+     ((uint8_t (*)(void))ROMAPI3_U32TOA)())
+
+#define rom_u16tohex(val, buf) \
+    (*(volatile uint16_t*)0xF0 = (val), \
+     *(volatile uint16_t*)0xF4 = (uint16_t)(buf), \
+     ((uint8_t (*)(void))ROMAPI3_U16TOHEX)())
+
+/* cmd_register: comandos de usuario en el monitor                   */
+/*   El nodo debe seguir en RAM mientras el programa esté residente.  */
+/*   name en mayúsculas (3-8 letras recomendado); fn recibe el resto  */
+/*   de la línea y retorna 0. rom_cmd_register(0) borra la lista.     */
+#define ROM_UCMD_TAG    0xC5
+
+typedef struct rom_ucmd {
+    struct rom_ucmd *next;      /* lo rellena el monitor */
+    const char *name;
+    uint8_t (*fn)(const char *args);
+    uint8_t tag;                /* ROM_UCMD_TAG */
+} rom_ucmd_t;
+
+#define rom_cmd_register(node) \
+    (*(volatile uint16_t*)0xF0 = (uint16_t)(node), \
+     ((void (*)(void))ROMAPI3_CMD_REGISTER)())
+
+/* ext_register: un mdulo residente atiende un tramo de ranuras      */
+/*   vec[i] es la rutina de la ranura first + i; entra con la misma    */
+/*   convencin que la entrada de la ROM. Retorna 0, o $FF si el tramo */
+/*   no es vlido. rom_ext_register(0) devuelve todas a $FF. Si un     */
+/*   LOAD, XRECV u overlay pisa el mdulo, el monitor las quita.      */
+typedef struct {
+    uint8_t first;              /* ROMAPI_X_* */
+    uint8_t count;
+    void   *vec[1];             /* count vectores */
+} rom_ext_t;
+
+#define rom_ext_register(ext) \
+    (*(volatile uint16_t*)0xF0 = (uint16_t)(ext), \
+     ((uint8_t (*)(void))ROMAPI3_EXT_REGISTER)())
+
+/* lz_unpack: descomprime LZ65 (scripts/lzpack.py), ranura LZ que     */
+/*   atiende modules/LZ.X65. src = 0: desde el archivo abierto con    */
+/*   rom3_mfs_open. Sin solapar. Retorna los bytes escritos           */
+#define rom_lz_unpack(src, dst) \
+    (*(volatile uint16_t*)0xF0 = (uint16_t)(src), \
+     *(volatile uint16_t*)0xF2 = (uint16_t)(dst), \
+     ((uint16_t (*)(void))ROMAPI3_LZ_UNPACK)())
+
+/* Arena y pools (ranuras ALLOC, modules/ALLOC.X65) sobre una regin  */
+/*   de la RAM del programa: el estado vive al principio de la regin  */
+/*   (ROM_ARENA_HDR / ROM_POOL_HDR bytes), sin heap de CC65. Arena:    */
+/*   asignacin por avance, mark y release liberan todo lo posterior   */
+/*   a la marca. Pool: bloques de tamao fijo (>= 2) con alloc/free    */
+/*   O(1). 0 = sin memoria.                                            */
+#define ROM_ARENA_HDR   4
+#define ROM_POOL_HDR    2
+
+#define rom_arena_init(region, size) \
+    (*(volatile uint16_t*)0xF0 = (uint16_t)(region), \
+     *(volatile uint16_t*)0xF2 = (size), \
+     ((uint16_t (*)(void))ROMAPI3_ARENA_INIT)())
+
+#define rom_arena_alloc(arena, n) \
+    (*(volatile uint16_t*)0xF0 = (uint16_t)(arena), \
+     *(volatile uint16_t*)0xF2 = (n), \
+     ((void *(*)(void))ROMAPI3_ARENA_ALLOC)())
+
+#define rom_arena_mark(arena) \
+    (*(volatile uint16_t*)0xF0 = (uint16_t)(arena), \
+     ((uint16_t (*)(void))ROMAPI3_ARENA_MARK)())
+
+#define rom_arena_release(arena, mark) \
+    (*(volatile uint16_t*)0xF0 = (uint16_t)(arena), \
+     *(volatile uint16_t*)0xF2 = (mark), \
+     ((void (*)(void))ROMAPI3_ARENA_RELEASE)())
+
+#define rom_pool_init(region, size, block) \
+    (*(volatile uint16_t*)0xF0 = (uint16_t)(region), \
+     *(volatile uint16_t*)0xF2 = (size), \
+     *(volatile uint16_t*)0xF4 = (block), \
+     ((uint16_t (*)(void))ROMAPI3_POOL_INIT)())
+
+#define rom_pool_alloc(pool) \
+    (*(volatile uint16_t*)0xF0 = (uint16_t)(pool), \
+     ((void *(*)(void))ROMAPI3_POOL_ALLOC)())
+
+#define rom_pool_free(pool, p) \
+    (*(volatile uint16_t*)0xF0 = (uint16_t)(pool), \
+     *(volatile uint16_t*)0xF2 = (uint16_t)(p), \
+     ((void (*)(void))ROMAPI3_POOL_FREE)())
+
+/* Tareas en segundo plano (ranuras TASK, modules/SCHED.X65): fn     */
+/*   corre cada period ticks (1024 us) mientras el monitor espera     */
+/*   teclas, o en rom_task_yield() desde el bucle del programa. fn    */
+/*   debe ser corta y retornar ROM_TASK_KEEP o ROM_TASK_DONE          */
+/*   (quitarla). Corre sobre el stack de quien cede; su ZP (zp,       */
+/*   zp_len) se guarda en zp_save entre llamadas para no pisar la del */
+/*   programa en primer plano. El descriptor debe seguir en RAM       */
+/*   mientras est registrada.                                        */
+#define ROM_TASK_TAG    0x7A
+#define ROM_TASK_KEEP   0
+#define ROM_TASK_DONE   1
+#define ROM_TASK_FULL   0xFF
+#define ROM_TASK_TICK_US 1024
+
+typedef struct rom_task {
+    uint8_t (*fn)(void);
+    uint16_t period;            /* ticks, 0 = en cada yield */
+    uint8_t zp;                 /* primera direccin de ZP propia */
+    uint8_t zp_len;             /* 0 = sin ZP propia */
+    uint8_t *zp_save;           /* zp_len bytes */
+    uint16_t due;               /* lo rellena el mdulo */
+    uint8_t tag;                /* ROM_TASK_TAG */
+} rom_task_t;
+
+#define rom_task_add(task) \
+    (*(volatile uint16_t*)0xF0 = (uint16_t)(task), \
+     ((uint8_t (*)(void))ROMAPI3_TASK_ADD)())
+
+#define rom_task_remove(task) \
+    (*(volatile uint16_t*)0xF0 = (uint16_t)(task), \
+     ((void (*)(void))ROMAPI3_TASK_REMOVE)())
+
+#define rom_task_yield() \
+    (((void (*)(void))ROMAPI3_TASK_YIELD)())
+
+/* Alarmas (ranuras ALARM, tambin modules/SCHED.X65): fn(a) tras us  */
+/*   microsegundos (< 2^31), de un disparo o cada period us (sin      */
+/*   deriva). Lista ordenada en la RAM del programa; se despachan en  */
+/*   rom_task_yield() y mientras el monitor espera teclas, as que un */
+/*   programa que antes esperaba en delay_ms puede ceder en su bucle  */
+/*   y seguir trabajando. fn corre sobre el stack del que cede y      */
+/*   puede volver a programarse.                                      */
+#define ROM_ALARM_TAG   0xA1
+
+typedef struct rom_alarm {
+    struct rom_alarm *next;     /* lo rellena el mdulo */
+    uint32_t due;               /* lo rellena el mdulo */
+    uint32_t period;            /* us, 0 = un disparo */
+    void (*fn)(struct rom_alarm *a);
+    uint8_t tag;                /* ROM_ALARM_TAG */
+} rom_alarm_t;
+
+#define rom_alarm_set(a, us) \
+    (*(volatile uint16_t*)0xF0 = (uint16_t)(a), \
+     *(volatile uint32_t*)0xF2 = (us), \
+     ((uint8_t (*)(void))ROMAPI3_ALARM_SET)())
+
+#define rom_alarm_cancel(a) \
+    (*(volatile uint16_t*)0xF0 = (uint16_t)(a), \
+     ((void (*)(void))ROMAPI3_ALARM_CANCEL)())
+
+/* I2C en bloque (modules/I2CBLK.X65): dev de 7 bits, ab = bytes de   */
+/*   direccin interna (0-2, big-endian), mem = direccin. Retornan */
+/*   los bytes transferidos (< len si hubo NACK) y dejan $F0/$F2/$F6  */
+/*   avanzados. page (potencia de 2, <= 128): escritura EEPROM partida */
+/*   en pginas, con ACK polling tras cada una; 0 = una escritura.    */
+#define ROM_I2C_SETUP(buf, len, dev, ab, mem) \
+    (*(volatile uint16_t*)0xF0 = (uint16_t)(buf), \
+     *(volatile uint16_t*)0xF2 = (len), \
+     *(volatile uint8_t*)0xF4 = (dev), \
+     *(volatile uint8_t*)0xF5 = (ab), \
+     *(volatile uint16_t*)0xF6 = (mem))
+
+#define rom_i2c_write_buf(dev, ab, mem, buf, len, page) \
+    (ROM_I2C_SETUP(buf, len, dev, ab, mem), \
+     ((uint16_t (*)(uint8_t))ROMAPI3_I2C_WRITE_BUF)(page))
+
+#define rom_i2c_read_buf(dev, ab, mem, buf, len) \
+    (ROM_I2C_SETUP(buf, len, dev, ab, mem), \
+     ((uint16_t (*)(void))ROMAPI3_I2C_READ_BUF)())
+
+/* Contadores de errores y actividad (STATS.OVL). De 16 bits, dan la  */
+/*   vuelta y se ponen a cero al arrancar. rom_stats() retorna el     */
+/*   bloque vivo de la ROM: para una instantnea, copiarlo; para      */
+/*   reiniciarlo, ponerlo a cero. Solo crece por el final.            */
+typedef struct {
+    uint16_t xm_nak;            /* bloques XMODEM rechazados (NAK) */
+    uint16_t xm_timeout;        /* recepciones XMODEM cortadas sin EOT */
+    uint16_t dir_hit;           /* nombres hallados en el ndice */
+    uint16_t dir_miss;          /* nombres fuera del ndice */
+    uint16_t dd_retry;          /* tramas DDR/DDW reenviadas */
+} rom_stats_t;
+
+#define rom_stats() \
+    (((rom_stats_t *(*)(void))ROMAPI3_STATS_READ)())
+
+/* ext_features: bits 0-15 como $BF8B, 16-23 como $BF8D, ms los de  */
+/*   las familias que tienen mdulo instalado en este momento         */
+#define rom_ext_features() \
+    (((uint32_t (*)(void))ROMAPI3_EXT_FEATURES)())
+
 /* mfs_create:  $F4-$F5 = name ptr,  $F6-$F7 = size */
 #define rom_mfs_create_via_zp(name, size) \
     (*(volatile uint16_t*)0xF4 = (uint16_t)(name), \
@@ -265,6 +697,46 @@ typedef struct {
      *(volatile uint16_t*)0xF6 = (len), \
      ((uint16_t (*)(void))ROMAPI_MFS_WRITE)())
 
+/* mfs_stream_open:  $F4-$F5 = name,  $F6-$F7 = anillo,  A = flags  */
+/*   Mdulo STREAM (modules/). Anillo de 2 sectores (1024 bytes) en  */
+/*   RAM del programa. Los bytes se leen de RAM; la mitad consumida  */
+/*   se recarga en poll (POLL) o al cruzar la mitad del anillo (AUTO) */
+#define ROM_STREAM_RING_SIZE    1024
+#define ROM_STREAM_POLL         0x00
+#define ROM_STREAM_AUTO         0x01
+#define ROM_STREAM_EOF          (-1)
+
+#define rom_mfs_stream_open_via_zp(name, ring, flags) \
+    (*(volatile uint16_t*)0xF4 = (uint16_t)(name), \
+     *(volatile uint16_t*)0xF6 = (uint16_t)(ring), \
+     ((uint8_t (*)(uint8_t))ROMAPI_MFS_STREAM_OPEN)(flags))
+
+/* mfs_seek:  $F0-$F3 = posicin en el stream abierto. MicroFS lee  */
+/*   en secuencia: avanza leyendo y hacia atrs reabre (O(n)).     */
+/*   Retorna 0, o $FF si el archivo es ms corto                     */
+#define rom_mfs_seek_via_zp(pos) \
+    (*(volatile uint32_t*)0xF0 = (pos), \
+     ((uint8_t (*)(void))ROMAPI_MFS_SEEK)())
+
+/* spi_transfer_block:  $F0-$F1 = buf,  $F2-$F3 = len,  A = modo */
+/*   Mdulo SPIBLK (modules/). CS debe estar seleccionado.       */
+#define ROM_SPI_BLK_READ    0xFF    /* envia $FF, guarda en buf */
+#define ROM_SPI_BLK_WRITE   0x00    /* envia buf, descarta RX   */
+
+#define rom_spi_transfer_block_via_zp(buf, len, mode) \
+    (*(volatile uint16_t*)0xF0 = (uint16_t)(buf), \
+     *(volatile uint16_t*)0xF2 = (len), \
+     ((void (*)(uint8_t))ROMAPI_SPI_XFER_BLOCK)(mode))
+
+/* spi_xfer_buf: full duplex, tx = 0 enva $FF, rx = 0 descarta.      */
+/*   tx y rx pueden ser el mismo buffer. Mdulo SPIBLK, CS            */
+/*   seleccionado.                                                    */
+#define rom_spi_xfer_buf(tx, rx, len) \
+    (*(volatile uint16_t*)0xF0 = (uint16_t)(tx), \
+     *(volatile uint16_t*)0xF2 = (uint16_t)(rx), \
+     *(volatile uint16_t*)0xF4 = (len), \
+     ((void (*)(void))ROMAPI3_SPI_XFER_BUF)())
+
 /* sd_read_sector:  $F0-$F3 = sector (uint32),  $F4-$F5 = buf ptr */
 #define rom_sd_read_sector_via_zp(sector, buf) \
     (*(volatile uint32_t*)0xF0 = (sector), \
@@ -279,10 +751,13 @@ typedef struct {
 
 /* mfs_load_file: Carga archivo SD a memoria */
 /*   $F4-$F5 = nombre archivo, $F6-$F7 = direccion destino */
+/*   Con cabecera X65 (ROMAPI_FEAT_EXEHDR) la direccion sale de ella. */
+/*   addr 0: $0800. */
+/*   Retorna el punto de entrada, 0 si falla */
 #define rom_mfs_load_file(name, addr) \
     (*(volatile uint16_t*)0xF4 = (uint16_t)(name), \
      *(volatile uint16_t*)0xF6 = (addr), \
-     ((void (*)(void))ROMAPI_MFS_LOAD_FILE)())
+     ((uint16_t (*)(void))ROMAPI_MFS_LOAD_FILE)())
 
 /* mfs_load_run: Carga archivo SD y lo ejecuta */
 /*   $F4-$F5 = nombre archivo, $F6-$F7 = direccion destino */
@@ -323,6 +798,7 @@ typedef struct {
 #define MFS_ERR_NOTFOUND    3
 #define MFS_ERR_FULL        4
 #define MFS_ERR_EXISTS      5
+#define MFS_ERR_PARTIAL     0x10  /* listado del indice incompleto */
 
 /* XMODEM */
 #define XMODEM_ERROR_TIMEOUT   -1
@@ -355,6 +831,29 @@ typedef struct {
  *       }
  *   }
  * 
+ *  Streaming con el mdulo STREAM (ej: reproductor SID)
+ *   static uint8_t ring[ROM_STREAM_RING_SIZE];
+ *   rom_mfs_stream_open_via_zp("SONG.DAT", ring, ROM_STREAM_POLL);
+ *   while ((c = rom_mfs_stream_getc()) != ROM_STREAM_EOF) {
+ *       // escribir registro SID...
+ *       if (tick) rom_mfs_stream_poll();   // fuera de la IRQ
+ *   }
+ *   rom_mfs_stream_close();
+ * 
+ *  Listar archivos desde el indice del monitor
+ *   rom_mfs_fileinfo32_t fi;
+ *   uint16_t i = 0;
+ *   while (rom_mfs_list_ext_via_zp(i, &fi) == MFS_OK) {
+ *       // fi.name, fi.size
+ *       i++;
+ *   }
+ *   // MFS_ERR_PARTIAL: seguir con rom_mfs_list_via_zp (lee la SD)
+ * 
+ *  Detectar bloque v3 y usarlo si existe
+ *   if (rom_has_feature(ROMAPI_FEAT_V3)) {
+ *       while (rom3_mfs_list(i, &fi) == MFS_OK) i++;
+ *   }
+ * 
  *  Sector raw (via ZP wrapper) 
  *   rom_sd_read_sector_via_zp(0, buffer);  // leer sector 0
  * 
@@ -376,6 +875,10 @@ typedef struct {
  *   }
  *   uint8_t d = rom_i2c_read_byte(0);  // NACK = last byte
  * 
+ *  I2C en bloque (mdulo I2CBLK, ROMAPI_FEAT_BUSBLK) 
+ *   rom_i2c_read_buf(0x50, 2, 0x0000, cfg, 32);       // 24C256
+ *   rom_i2c_write_buf(0x50, 2, 0x0000, cfg, 32, 64);  // pginas de 64
+ * 
  *  Timer (fastcall, directo) 
  *   rom_delay_ms(500);
  *   uint32_t t = rom_get_micros();
@@ -0,0 +1,119 @@
+;; ===========================================================================
+;; ROMRT.S - Stub del runtime de CC65 residente en ROM (monitor v3.3+)
+;; ===========================================================================
+;;
+;; Enlazar este módulo EN LUGAR de none.lib:
+;;
+;;   ca65 -t none -o build/romrt.o ../../include/romrt.s
+;;   ld65 -C config/programa.cfg -o prog.bin startup.o main.o build/romrt.o
+;;
+;; Define los helpers del runtime como direcciones de la tabla $BD00
+;; de la ROM (src/rtexport.s), las variables ZP del runtime en las
+;; direcciones del monitor ($0E-$27) y jmpvec en el DATA del programa.
+;; El ZP del programa empieza en $28.
+;;
+;; Requiere ROM API con ROMAPI_FEAT_RUNTIME ($BF8B). La tabla no trae
+;; multiplicación/división (tosmulax, tosudivax...), desplazamientos con
+;; signo o de cuenta variable (asraxN, shlaxy...) ni comparaciones con
+;; signo a bool (tosltax...). Si el linker los da como sin resolver,
+;; usar la ROM API de math o añadir none.lib DESPUÉS de romrt.o: ld65
+;; solo toma de la librería los módulos que faltan.
+;; ===========================================================================
+
+; Variables ZP del runtime (compartidas con el monitor)
+.exportzp sp      := $0E
+.exportzp sreg    := $10
+.exportzp regsave := $12
+.exportzp ptr1    := $16
+.exportzp ptr2    := $18
+.exportzp ptr3    := $1A
+.exportzp ptr4    := $1C
+.exportzp tmp1    := $1E
+.exportzp tmp2    := $1F
+.exportzp tmp3    := $20
+.exportzp tmp4    := $21
+.exportzp regbank := $22
+
+; Helpers del runtime (tabla de saltos en ROM)
+.export pusha     := $BD00
+.export pusha0    := $BD03
+.export pushax    := $BD06
+.export push0     := $BD09
+.export push1     := $BD0C
+.export popa      := $BD0F
+.export popax     := $BD12
+.export incsp1    := $BD15
+.export incsp2    := $BD18
+.export incsp3    := $BD1B
+.export incsp4    := $BD1E
+.export incsp5    := $BD21
+.export incsp6    := $BD24
+.export incsp7    := $BD27
+.export incsp8    := $BD2A
+.export decsp1    := $BD2D
+.export decsp2    := $BD30
+.export decsp3    := $BD33
+.export decsp4    := $BD36
+.export decsp5    := $BD39
+.export decsp6    := $BD3C
+.export decsp7    := $BD3F
+.export decsp8    := $BD42
+.export addysp    := $BD45
+.export subysp    := $BD48
+.export ldax0sp   := $BD4B
+.export ldaxysp   := $BD4E
+.export staxysp   := $BD51
+.export stax0sp   := $BD54
+.export pushwysp  := $BD57
+.export ldaxi     := $BD5A
+.export ldaidx    := $BD5D
+.export ldauidx   := $BD60
+.export tosaddax  := $BD63
+.export tossubax  := $BD66
+.export tosandax  := $BD69
+.export tosorax   := $BD6C
+.export tosxorax  := $BD6F
+.export aslax1    := $BD72
+.export aslax2    := $BD75
+.export aslax3    := $BD78
+.export aslax4    := $BD7B
+.export shlax1    := $BD7E
+.export shlax2    := $BD81
+.export shlax3    := $BD84
+.export shlax4    := $BD87
+.export shrax1    := $BD8A
+.export shrax2    := $BD8D
+.export shrax3    := $BD90
+.export shrax4    := $BD93
+.export booleq    := $BD96
+.export boolne    := $BD99
+.export boollt    := $BD9C
+.export boolle    := $BD9F
+.export boolgt    := $BDA2
+.export boolge    := $BDA5
+.export boolult   := $BDA8
+.export boolule   := $BDAB
+.export boolugt   := $BDAE
+.export booluge   := $BDB1
+.export toseqax   := $BDB4
+.export tosneax   := $BDB7
+.export tosultax  := $BDBA
+.export tosuleax  := $BDBD
+.export tosugtax  := $BDC0
+.export tosugeax  := $BDC3
+.export tosicmp   := $BDC6
+.export negax     := $BDC9
+.export complax   := $BDCC
+.export bnegax    := $BDCF
+.export incax1    := $BDD2
+.export decax1    := $BDD5
+.export callax    := $BDD8
+
+; Vector de las llamadas indirectas: CC65 lo usa en cada llamada por
+; puntero a función (también en las macros rom_xxx de romapi.h). Se
+; modifica al llamar, así que va en el DATA (RAM) del programa
+.export jmpvec
+
+.segment "DATA"
+jmpvec:
+    jmp     $0000
@@ -9,10 +9,21 @@
 #include "../sdcard-spi-6502-cc65/sdcard.h"
 #include "../microfs-6502-cc65/microfs.h"
 #include "../../src/xmodem.h"
+#include "../../src/fastmath.h"
+#include "../../src/msgdec.h"
+#include "../../src/mem_ops.h"
 
 /* Reset por software */
 extern void soft_reset(void);
 
+/* Timer hardware (timer_minimal.s) */
+extern uint32_t get_micros(void);
+
+/* Ranuras de extensión de la ROM API (romapi.s) */
+extern void mon_ext_reset(void);
+extern void mon_ext_drop(uint8_t lo, uint8_t hi);
+extern void mon_idle(void);     /* task_yield ($BE54): tareas del módulo SCHED */
+
 /* Hardware */
 #define LEDS (*(volatile unsigned char *)0xC001)
 
@@ -23,12 +34,21 @@ static uint8_t input_pos;
 /* Última dirección usada (para comandos continuos) */
 static uint16_t last_addr = 0x0200;
 
+/* Origen y bytes del último LOAD o XRECV (registro del auto-boot y
+ * ventana de overlays) */
+static uint16_t last_base;
+static uint16_t last_len;
+
+/* Cabecera del último ejecutable cargado (magic[0] = 0 si no había) */
+static mon_exe_hdr_t exe_hdr;
+
 /* Estado SD Card */
 static uint8_t sd_initialized = 0;
 static uint8_t fs_mounted = 0;
+static uint8_t fs_lazy;         /* montar en el primer acceso (reset en caliente) */
 
-/* Tabla de caracteres hex */
-static const char hex_chars[] = "0123456789ABCDEF";
+/* Marcas de tiempo del arranque (BOOT_T_xxx) */
+static uint32_t boot_t[BOOT_T_COUNT];
 
 /* ============================================
  * FUNCIONES DE UTILIDAD - IMPRESIÓN
@@ -39,18 +59,13 @@ void mon_newline(void) {
     uart_putc('\n');
 }
 
+/* Formato en ROM (fastmath.s): sin tabla ni división de CC65 */
 void mon_print_hex8(uint8_t val) {
-    uart_putc(hex_chars[(val >> 4) & 0x0F]);
-    uart_putc(hex_chars[val & 0x0F]);
+    uart_puts(fmt_hex16(val) + 2);
 }
 
 void mon_print_hex16(uint16_t val) {
-    mon_print_hex8((uint8_t)(val >> 8));
-    mon_print_hex8((uint8_t)(val & 0xFF));
-}
-
-static void mon_print_space(void) {
-    uart_putc(' ');
+    uart_puts(fmt_hex16(val));
 }
 
 static void mon_prompt(void) {
@@ -58,9 +73,9 @@ static void mon_prompt(void) {
     uart_putc('>');
 }
 
-static void mon_error(const char *msg) {
-    uart_puts("ERR: ");
-    uart_puts(msg);
+static void mon_error(uint8_t msg) {
+    mon_msg(MSG_ERR);
+    mon_msg(msg);
     mon_newline();
 }
 
@@ -73,55 +88,29 @@ static void mon_error(const char *msg) {
  */
 static uint8_t hex_char_to_val(char c) {
     if (c >= '0' && c <= '9') return c - '0';
+    c &= 0xDF;                          /* A mayúsculas */
     if (c >= 'A' && c <= 'F') return c - 'A' + 10;
-    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
     return 0xFF; /* Error */
 }
 
-/**
- * Verificar si es carácter hex válido
- */
-static uint8_t is_hex_char(char c) {
-    return (c >= '0' && c <= '9') ||
-           (c >= 'A' && c <= 'F') ||
-           (c >= 'a' && c <= 'f');
-}
-
-uint8_t mon_hex_to_u8(const char *str) {
-    uint8_t result = 0;
-    uint8_t i;
-    
-    for (i = 0; i < 2 && str[i] != '\0'; i++) {
-        if (!is_hex_char(str[i])) break;
-        result = (result << 4) | hex_char_to_val(str[i]);
-    }
-    return result;
-}
-
-uint16_t mon_hex_to_u16(const char *str) {
-    uint16_t result = 0;
-    uint8_t i;
-    
-    for (i = 0; i < 4 && str[i] != '\0'; i++) {
-        if (!is_hex_char(str[i])) break;
-        result = (result << 4) | hex_char_to_val(str[i]);
-    }
-    return result;
-}
+/* is_hex_char, mon_hex_to_u8 y mon_hex_to_u16 removed to save space
+ * (sin usos: parse_hex_token se basta con hex_char_to_val) */
 
 /**
  * Parsear siguiente token hex de la cadena
  * Retorna puntero al siguiente espacio o fin de cadena
  */
 static const char* parse_hex_token(const char *str, uint16_t *value) {
+    uint8_t v;
+
     *value = 0;
     
     /* Saltar espacios */
     while (*str == ' ') str++;
     
     /* Parsear hex */
-    while (is_hex_char(*str)) {
-        *value = (*value << 4) | hex_char_to_val(*str);
+    while ((v = hex_char_to_val(*str)) != 0xFF) {
+        *value = (*value << 4) | v;
         str++;
     }
     
@@ -157,7 +146,7 @@ void mon_dump(uint16_t addr, uint16_t len) {
         for (j = 0; j < 16 && (i + j) < len; j++) {
             data[j] = mon_read_byte(row_addr + j);
             mon_print_hex8(data[j]);
-            mon_print_space();
+            uart_putc(' ');
         }
         
         /* Padding si línea incompleta */
@@ -196,7 +185,7 @@ void mon_fill(uint16_t addr, uint16_t len, uint8_t value) {
 void mon_execute(uint16_t addr) {
     code_ptr code = (code_ptr)addr;
     
-    uart_puts("Ejecutando en $");
+    mon_msg(MSG_EXEC);
     mon_print_hex16(addr);
     uart_puts("...");
     mon_newline();
@@ -206,7 +195,7 @@ void mon_execute(uint16_t addr) {
     
     /* Si retorna, mostrar mensaje */
     mon_newline();
-    uart_puts("Retorno de $");
+    mon_msg(MSG_RETURN);
     mon_print_hex16(addr);
     mon_newline();
 }
@@ -215,216 +204,13 @@ void mon_execute(uint16_t addr) {
  * MODO CARGA DE BYTES
  * ============================================ */
 
-/**
- * Modo carga: recibe bytes hex separados por espacio
- * Termina con '.' o línea vacía
- */
-static void mon_load_mode(uint16_t addr) {
-    char c;
-    uint8_t byte_val;
-    uint8_t nibble_count = 0;
-    uint16_t bytes_loaded = 0;
-    
-    uart_puts("Modo carga en $");
-    mon_print_hex16(addr);
-    uart_puts(" (terminar con '.')");
-    mon_newline();
-    uart_putc(':');
-    
-    byte_val = 0;
-    
-    while (1) {
-        c = uart_getc();
-        
-        /* Terminar con punto */
-        if (c == '.') {
-            break;
-        }
-        
-        /* Enter - nueva línea de entrada */
-        if (c == '\r' || c == '\n') {
-            mon_newline();
-            uart_putc(':');
-            continue;
-        }
-        
-        /* Espacio - separador */
-        if (c == ' ') {
-            uart_putc(' ');
-            continue;
-        }
-        
-        /* Procesar hex */
-        if (is_hex_char(c)) {
-            uart_putc(c); /* Echo */
-            byte_val = (byte_val << 4) | hex_char_to_val(c);
-            nibble_count++;
-            
-            if (nibble_count == 2) {
-                /* Byte completo - escribir */
-                mon_write_byte(addr, byte_val);
-                addr++;
-                bytes_loaded++;
-                byte_val = 0;
-                nibble_count = 0;
-            }
-        }
-    }
-    
-    mon_newline();
-    uart_puts("Cargados ");
-    mon_print_hex16(bytes_loaded);
-    uart_puts(" bytes");
-    mon_newline();
-    
-    last_addr = addr;
-}
+/* L: overlay HEXLOAD.OVL (overlays/src/hexload.c) */
 
 /* ============================================
  * DESENSAMBLADOR BÁSICO
  * ============================================ */
 
-/* Tabla simplificada de mnemonics (solo instrucciones comunes) */
-static const char* get_mnemonic(uint8_t opcode) {
-    switch (opcode) {
-        case 0x00: return "BRK";
-        case 0x20: return "JSR";
-        case 0x40: return "RTI";
-        case 0x60: return "RTS";
-        case 0x4C: return "JMP";
-        case 0x6C: return "JMP()";
-        case 0xA9: return "LDA#";
-        case 0xA5: return "LDAzp";
-        case 0xAD: return "LDAab";
-        case 0xA2: return "LDX#";
-        case 0xA0: return "LDY#";
-        case 0x85: return "STAzp";
-        case 0x8D: return "STAab";
-        case 0x86: return "STXzp";
-        case 0x84: return "STYzp";
-        case 0xE8: return "INX";
-        case 0xC8: return "INY";
-        case 0xCA: return "DEX";
-        case 0x88: return "DEY";
-        case 0x18: return "CLC";
-        case 0x38: return "SEC";
-        case 0xD8: return "CLD";
-        case 0xF8: return "SED";
-        case 0x58: return "CLI";
-        case 0x78: return "SEI";
-        case 0xEA: return "NOP";
-        case 0xAA: return "TAX";
-        case 0xA8: return "TAY";
-        case 0x8A: return "TXA";
-        case 0x98: return "TYA";
-        case 0x9A: return "TXS";
-        case 0xBA: return "TSX";
-        case 0x48: return "PHA";
-        case 0x68: return "PLA";
-        case 0x08: return "PHP";
-        case 0x28: return "PLP";
-        case 0x69: return "ADC#";
-        case 0xE9: return "SBC#";
-        case 0xC9: return "CMP#";
-        case 0xE0: return "CPX#";
-        case 0xC0: return "CPY#";
-        case 0x29: return "AND#";
-        case 0x09: return "ORA#";
-        case 0x49: return "EOR#";
-        case 0xD0: return "BNE";
-        case 0xF0: return "BEQ";
-        case 0x10: return "BPL";
-        case 0x30: return "BMI";
-        case 0x90: return "BCC";
-        case 0xB0: return "BCS";
-        case 0x50: return "BVC";
-        case 0x70: return "BVS";
-        default:   return "???";
-    }
-}
-
-/* Bytes por instrucción (simplificado) */
-static uint8_t get_instruction_len(uint8_t opcode) {
-    /* Implied/Accumulator - 1 byte */
-    if (opcode == 0x00 || opcode == 0x40 || opcode == 0x60 ||
-        opcode == 0xE8 || opcode == 0xC8 || opcode == 0xCA ||
-        opcode == 0x88 || opcode == 0x18 || opcode == 0x38 ||
-        opcode == 0xD8 || opcode == 0xF8 || opcode == 0x58 ||
-        opcode == 0x78 || opcode == 0xEA || opcode == 0xAA ||
-        opcode == 0xA8 || opcode == 0x8A || opcode == 0x98 ||
-        opcode == 0x9A || opcode == 0xBA || opcode == 0x48 ||
-        opcode == 0x68 || opcode == 0x08 || opcode == 0x28) {
-        return 1;
-    }
-    
-    /* Immediate, Zero Page, Relative - 2 bytes */
-    if ((opcode & 0x0F) == 0x09 || /* Immediate */
-        (opcode & 0x0F) == 0x05 || /* Zero Page */
-        (opcode & 0x0F) == 0x06 || /* Zero Page */
-        (opcode & 0x1F) == 0x10 || /* Branches */
-        opcode == 0xA2 || opcode == 0xA0 ||
-        opcode == 0xE0 || opcode == 0xC0) {
-        return 2;
-    }
-    
-    /* Absolute, Indirect - 3 bytes */
-    if (opcode == 0x20 || opcode == 0x4C || opcode == 0x6C ||
-        (opcode & 0x0F) == 0x0D || /* Absolute */
-        (opcode & 0x0F) == 0x0E) {
-        return 3;
-    }
-    
-    /* Por defecto asumir 2 bytes */
-    return 2;
-}
-
-static void mon_disassemble(uint16_t addr, uint8_t lines) {
-    uint8_t i, j, len;
-    uint8_t opcode;
-    uint8_t bytes[3];
-    
-    for (i = 0; i < lines; i++) {
-        opcode = mon_read_byte(addr);
-        len = get_instruction_len(opcode);
-        
-        /* Leer bytes de la instrucción */
-        for (j = 0; j < len; j++) {
-            bytes[j] = mon_read_byte(addr + j);
-        }
-        
-        /* Imprimir dirección */
-        mon_print_hex16(addr);
-        uart_puts("  ");
-        
-        /* Imprimir bytes hex */
-        for (j = 0; j < 3; j++) {
-            if (j < len) {
-                mon_print_hex8(bytes[j]);
-            } else {
-                uart_puts("  ");
-            }
-            mon_print_space();
-        }
-        
-        /* Imprimir mnemonic */
-        uart_puts(get_mnemonic(opcode));
-        
-        /* Imprimir operando si hay */
-        if (len == 2) {
-            uart_puts(" $");
-            mon_print_hex8(bytes[1]);
-        } else if (len == 3) {
-            uart_puts(" $");
-            mon_print_hex8(bytes[2]);
-            mon_print_hex8(bytes[1]);
-        }
-        
-        mon_newline();
-        addr += len;
-    }
-    
-    last_addr = addr;
-}
+/* M: overlay DISASM.OVL (overlays/src/disasm.c) */
 
 /* ============================================
  * ANÁLISIS DE MEMORIA RAM
@@ -433,6 +219,7 @@ static void mon_disassemble(uint16_t addr, uint8_t lines) {
 /* Constantes del mapa de memoria */
 #define RAM_START       0x0100
 #define RAM_END         0x3DFF
+#define USER_START      0x0800
 #define ZP_START        0x0002
 #define ZP_END          0x00FF
 #define STACK_START     0x3E00
@@ -443,49 +230,29 @@ static void mon_disassemble(uint16_t addr, uint8_t lines) {
 #define IO_END          0xC0FF
 
 /**
- * Imprimir número decimal (hasta 65535)
+ * Imprimir número decimal (hasta 4294967295, tamaños MicroFS v2)
  */
-static void mon_print_dec(uint16_t val) {
-    char buf[6];
-    uint8_t i = 0;
-    
-    if (val == 0) {
-        uart_putc('0');
-        return;
-    }
-    
-    while (val > 0) {
-        buf[i++] = '0' + (val % 10);
-        val /= 10;
-    }
-    
-    while (i > 0) {
-        uart_putc(buf[--i]);
-    }
+static void mon_print_dec(uint32_t val) {
+    uart_puts(fmt_u32(val));
 }
 
 /**
  * Mostrar información del sistema (mapa de memoria)
  */
 static void mon_info(void) {
-    mon_newline();
-    uart_puts("=== MAPA MEMORIA ===");
-    mon_newline();
-    mon_newline();
-    
-    uart_puts("ZP:  $0002-$00FF");
-    mon_newline();
-    uart_puts("RAM: $0100-$3DFF");
-    mon_newline();
-    uart_puts("Stk: $3E00-$3FFF");
-    mon_newline();
-    uart_puts("ROM: $8000-$BFFF");
-    mon_newline();
-    uart_puts("I/O: $C000-$C0FF");
-    mon_newline();
-    mon_newline();
-    uart_puts("Progs: $0800-$3DFF");
-    mon_newline();
+    uint8_t i;
+
+    mon_msg(MSG_INFO);
+    mon_msg(MSG_BOOT_T);
+    for (i = 0; i < BOOT_T_COUNT; i++) {
+        mon_msg(MSG_T_MAIN + i);
+        if (boot_t[i]) {
+            mon_print_dec(boot_t[i]);
+        } else {
+            uart_putc('-');
+        }
+        mon_newline();
+    }
 }
 
 /**
@@ -505,6 +272,222 @@ static void mon_info(void) {
  */
 /* mon_memmap removed to save space */
 
+/* ============================================
+ * ÍNDICE DE DIRECTORIO EN RAM
+ * ============================================ */
+/* El directorio se lee UNA vez al montar. LS, LOAD, DEL, CAT y el
+ * auto-boot resuelven nombres aquí sin tocar la SD. Las altas y bajas
+ * pasan por mon_fs_create/mon_fs_delete, que escriben en la SD y
+ * actualizan el índice (write-through).
+ * Si MicroFS admite más de MON_DIR_MAX archivos, el índice guarda los
+ * primeros y los nombres que no estén se buscan en la SD (dir_partial).
+ * El listado desde la RAM (mon_fs_list) se corta entonces con
+ * MON_FS_PARTIAL en vez de dar por completo un directorio a medias. */
+
+#if MFS_MAX_FILES > MON_DIR_MAX
+#define DIR_SLOTS   MON_DIR_MAX
+#else
+#define DIR_SLOTS   MFS_MAX_FILES
+#endif
+
+/* La ROM API lee el índice con mon_fs_list_zp ($BF90, $BE03) */
+static uint8_t dir_hash[DIR_SLOTS];     /* nunca 0 (dir_hash_name) */
+static mon_fileinfo_t dir_ent[DIR_SLOTS];
+static uint8_t dir_count;
+static uint8_t dir_partial;             /* 1 = hay archivos fuera del índice */
+static int8_t dir_open = -1;            /* entrada abierta con mon_fs_open */
+
+/* Hash de 8 bits del nombre, sin distinguir mayúsculas. Nunca 0 */
+static uint8_t dir_hash_name(const char *name) {
+    uint8_t h = 0;
+    uint8_t i;
+    char c;
+
+    for (i = 0; i < 12 && (c = name[i]) != '\0'; i++) {
+        if (c >= 'a' && c <= 'z') c -= 32;
+        h = (uint8_t)((h << 1) | (h >> 7)) ^ (uint8_t)c;
+    }
+    return h ? h : 1;
+}
+
+/* Comparar nombres sin distinguir mayúsculas */
+static uint8_t dir_name_eq(const char *a, const char *b) {
+    uint8_t i;
+    char ca, cb;
+
+    for (i = 0; i < 12; i++) {
+        ca = a[i];
+        cb = b[i];
+        if (ca >= 'a' && ca <= 'z') ca -= 32;
+        if (cb >= 'a' && cb <= 'z') cb -= 32;
+        if (ca != cb) return 0;
+        if (ca == '\0') break;
+    }
+    return 1;
+}
+
+/**
+ * Buscar nombre en el índice
+ * @return posición en dir_ent, o -1 si no existe
+ */
+static int8_t dir_find(const char *name) {
+    uint8_t h = dir_hash_name(name);
+    uint8_t i;
+
+    for (i = 0; i < dir_count; i++) {
+        if (dir_hash[i] == h && dir_name_eq(dir_ent[i].name, name)) {
+            ++mon_stats.dir_hit;
+            return (int8_t)i;
+        }
+    }
+    ++mon_stats.dir_miss;
+    return -1;
+}
+
+static void dir_add(const char *name, uint32_t size) {
+    mon_fileinfo_t *e;
+    uint8_t i;
+
+    if (dir_count >= DIR_SLOTS) {
+        dir_partial = 1;
+        return;
+    }
+
+    e = &dir_ent[dir_count];
+    for (i = 0; i < 12 && name[i] != '\0'; i++) {
+        e->name[i] = name[i];
+    }
+    e->name[i] = '\0';
+    e->size = size;
+    dir_hash[dir_count] = dir_hash_name(name);
+    dir_count++;
+}
+
+/* Quitar entrada: la última ocupa su lugar */
+static void dir_remove(uint8_t pos) {
+    dir_count--;
+    if (pos != dir_count) {
+        dir_ent[pos] = dir_ent[dir_count];
+        dir_hash[pos] = dir_hash[dir_count];
+    }
+    dir_open = -1;
+}
+
+/* Leer el directorio completo de la SD (solo al montar) */
+static void dir_load(void) {
+    mfs_fileinfo_t info;
+    uint16_t i;
+
+    dir_count = 0;
+    dir_partial = 0;
+    dir_open = -1;
+    for (i = 0; i < MFS_MAX_FILES; i++) {
+        if (mfs_list(i, &info) == MFS_OK) {
+            dir_add(info.name, info.size);
+        }
+    }
+}
+
+uint8_t mon_fs_mount(void) {
+    uint8_t r;
+
+    dir_count = 0;
+    r = mfs_mount();
+    if (r == MFS_OK) {
+        dir_load();
+    }
+    return r;
+}
+
+/* Tras un reset en caliente el programa se relanza sin que el monitor
+ * toque la SD: se inicializa y monta, sin mensajes, cuando el programa
+ * la pide por la ROM API */
+static void mon_fs_need(void) {
+    if (fs_lazy) {
+        fs_lazy = 0;
+        if (sd_init() == SD_OK) {
+            sd_initialized = 1;
+            fs_mounted = (mon_fs_mount() == MFS_OK);
+        }
+    }
+}
+
+uint8_t mon_fs_format(void) {
+    dir_count = 0;
+    dir_partial = 0;
+    dir_open = -1;
+    return mfs_format();
+}
+
+uint8_t mon_fs_create(const char *name, uint16_t size) {
+    uint8_t r;
+    uint8_t n;
+
+    mon_fs_need();
+    n = dir_count;
+    dir_open = -1;
+    r = mfs_create(name, size);
+    if (r == MFS_OK) {
+        dir_add(name, size);
+        /* Queda abierto: $BF93 debe dar su tamaño */
+        if (dir_count != n) dir_open = (int8_t)n;
+    }
+    return r;
+}
+
+uint8_t mon_fs_delete(const char *name) {
+    int8_t pos;
+    uint8_t r;
+
+    mon_fs_need();
+    pos = dir_find(name);
+    if (pos < 0) {
+        if (!dir_partial) return MFS_ERR_NOTFOUND;
+        return mfs_delete(name);
+    }
+
+    r = mfs_delete(dir_ent[pos].name);
+    if (r == MFS_OK) {
+        dir_remove((uint8_t)pos);
+    }
+    return r;
+}
+
+uint8_t mon_fs_open(const char *name) {
+    mon_fs_need();
+    dir_open = dir_find(name);
+    if (dir_open >= 0) {
+        return mfs_open(dir_ent[dir_open].name);
+    }
+    if (!dir_partial) return MFS_ERR_NOTFOUND;
+    return mfs_open(name);
+}
+
+void mon_fs_close(void) {
+    dir_open = -1;
+    mfs_close();
+}
+
+uint32_t mon_fs_get_size32(void) {
+    if (dir_open >= 0) {
+        return dir_ent[dir_open].size;
+    }
+    return mfs_get_size();
+}
+
+uint8_t mon_fs_list(uint16_t index, mon_fileinfo_t *info) {
+    mon_fs_need();
+    if (index >= dir_count) {
+        return dir_partial ? MON_FS_PARTIAL : MFS_ERR_NOTFOUND;
+    }
+    *info = dir_ent[index];
+    return MFS_OK;
+}
+
+uint8_t mon_fs_list_zp(void) {
+    return mon_fs_list(*(uint16_t *)0xF4, *(mon_fileinfo_t **)0xF6);
+}
+
 /* ============================================
  * FUNCIONES SD CARD
  * ============================================ */
@@ -515,12 +498,11 @@ static void mon_info(void) {
 static void mon_sd_init(void) {
     uint8_t r;
     
-    uart_puts("Inicializando SD Card...");
-    mon_newline();
+    mon_msg(MSG_SD_INIT);
     
     r = sd_init();
     if (r != SD_OK) {
-        uart_puts("  Error SD: ");
+        mon_msg(MSG_SD_ERR);
         mon_print_hex8(r);
         mon_newline();
         sd_initialized = 0;
@@ -529,26 +511,25 @@ static void mon_sd_init(void) {
     }
     
     sd_initialized = 1;
-    uart_puts("  SD OK, tipo: ");
+    mon_msg(MSG_SD_OK);
     uart_putc(sd_get_type() == 2 ? 'H' : 'S');
     uart_putc('D');
     mon_newline();
     
     /* Montar filesystem */
-    uart_puts("Montando MicroFS...");
-    mon_newline();
+    mon_msg(MSG_FS_MOUNTING);
     
-    r = mfs_mount();
+    r = mon_fs_mount();
     if (r == MFS_ERR_NOFS) {
-        uart_puts("  Sin FS. Formatear? (S/N): ");
-        if (uart_getc() == 'S' || uart_getc() == 's') {
+        mon_msg(MSG_FS_ASK);
+        if ((uart_getc() & 0xDF) == 'S') {     /* S o s */
             mon_newline();
-            uart_puts("  Formateando...");
-            r = mfs_format();
+            mon_msg(MSG_FS_FORMAT);
+            r = mon_fs_format();
             if (r == MFS_OK) {
                 uart_puts("OK");
                 mon_newline();
-                r = mfs_mount();
+                r = mon_fs_mount();
             }
         } else {
             mon_newline();
@@ -558,52 +539,63 @@ static void mon_sd_init(void) {
     
     if (r == MFS_OK) {
         fs_mounted = 1;
-        uart_puts("  FS montado OK");
+        mon_msg(MSG_FS_OK);
     } else {
-        uart_puts("  Error FS: ");
+        mon_msg(MSG_FS_ERR);
         mon_print_hex8(r);
     }
     mon_newline();
 }
 
+static void mon_sd_list_entry(const char *name, uint32_t size) {
+    uart_puts("  ");
+    uart_puts(name);
+    uart_puts("  ");
+    mon_print_dec(size);
+    mon_msg(MSG_BYTES);
+    mon_newline();
+}
+
 /**
  * Listar archivos en SD
  */
 static void mon_sd_list(void) {
     mfs_fileinfo_t info;
-    uint8_t i;
-    uint8_t count = 0;
+    uint16_t i;
+    uint16_t count = 0;
     
     if (!fs_mounted) {
-        uart_puts("SD no montada. Use SD primero");
-        mon_newline();
+        mon_msg(MSG_NO_FS_USE);
         return;
     }
     
-    uart_puts("Archivos:");
-    mon_newline();
+    mon_msg(MSG_FILES);
     
-    for (i = 0; i < MFS_MAX_FILES; i++) {
-        if (mfs_list(i, &info) == MFS_OK) {
-            uart_puts("  ");
-            uart_puts(info.name);
-            uart_puts("  ");
-            mon_print_dec(info.size);
-            uart_puts(" bytes");
-            mon_newline();
-            count++;
+    if (!dir_partial) {
+        /* Desde el índice en RAM, sin leer la SD */
+        for (i = 0; i < dir_count; i++) {
+            mon_sd_list_entry(dir_ent[i].name, dir_ent[i].size);
+        }
+        count = dir_count;
+    } else {
+        /* Más archivos que el índice: recorrer el directorio */
+        for (i = 0; i < MFS_MAX_FILES; i++) {
+            if (mfs_list(i, &info) == MFS_OK) {
+                mon_sd_list_entry(info.name, info.size);
+                count++;
+            }
         }
     }
     
     if (count == 0) {
-        uart_puts("  (vacio)");
-        mon_newline();
+        mon_msg(MSG_EMPTY);
     }
     
-    uart_puts("Total: ");
+    mon_msg(MSG_TOTAL);
     mon_print_dec(count);
-    uart_puts("/16 archivos");
-    mon_newline();
+    uart_putc('/');
+    mon_print_dec(MFS_MAX_FILES);
+    mon_msg(MSG_FILES_TAIL);
 }
 
 /**
@@ -614,34 +606,31 @@ static void mon_sd_save(const char *name, uint16_t addr, uint16_t len) {
     uint8_t r;
     uint16_t written = 0;
     uint16_t chunk;
-    uint8_t buf[64];
-    uint16_t i;
     
     if (!fs_mounted) {
-        uart_puts("SD no montada");
-        mon_newline();
+        mon_msg(MSG_NO_FS);
         return;
     }
     
-    if (len == 0 || len > 0x8000) {
-        uart_puts("Len invalido (1-8000h)");
-        mon_newline();
+    /* Como máximo 32 KB, y sin pasar de $FFFF */
+    if (len == 0 || len > 0x8000 || (uint16_t)(addr + len - 1) < addr) {
+        mon_msg(MSG_BAD_RANGE);
         return;
     }
     
-    /* Eliminar si existe */
-    mfs_delete(name);
+    /* Eliminar si existe (el índice evita leer la SD si no está) */
+    mon_fs_delete(name);
     
     /* Crear archivo */
-    r = mfs_create(name, len);
+    r = mon_fs_create(name, len);
     if (r != MFS_OK) {
-        uart_puts("Error crear: ");
+        mon_msg(MSG_CREATE_ERR);
         mon_print_hex8(r);
         mon_newline();
         return;
     }
     
-    uart_puts("Guardando $");
+    mon_msg(MSG_SAVING);
     mon_print_hex16(addr);
     uart_puts("-$");
     mon_print_hex16(addr + len - 1);
@@ -649,18 +638,11 @@ static void mon_sd_save(const char *name, uint16_t addr, uint16_t len) {
     uart_puts(name);
     mon_newline();
     
-    /* Escribir en chunks */
+    /* Escribir en chunks, directo desde la memoria */
     while (written < len) {
         chunk = len - written;
         if (chunk > 64) chunk = 64;
-        
-        /* Leer memoria */
-        for (i = 0; i < chunk; i++) {
-            buf[i] = mon_read_byte(addr + written + i);
-        }
-        
-        /* Escribir a archivo */
-        mfs_write(buf, chunk);
+        mfs_write((const void *)(addr + written), chunk);
         written += chunk;
         
         /* Mostrar progreso cada 1KB */
@@ -669,83 +651,172 @@ static void mon_sd_save(const char *name, uint16_t addr, uint16_t len) {
         }
     }
     
-    mfs_close();
+    mon_fs_close();
     
     mon_newline();
-    uart_puts("OK: ");
+    mon_msg(MSG_OK);
     mon_print_dec(written);
-    uart_puts(" bytes");
+    mon_msg(MSG_BYTES);
+    mon_newline();
+}
+
+/* ============================================
+ * CABECERA DE EJECUTABLE
+ * ============================================ */
+
+static uint8_t mon_exe_is_hdr(const uint8_t *p) {
+    return p[0] == MON_EXE_MAGIC0 && p[1] == MON_EXE_MAGIC1 &&
+           p[2] == MON_EXE_MAGIC2;
+}
+
+/* Copiar la cabecera a exe_hdr y validarla contra los bytes que la
+ * siguen. La imagen debe caer entera en la RAM de usuario
+ * ($0800-$3DFF): ni ZP, stack del 6502 y BSS del monitor, ni el stack
+ * de CC65 y el registro del auto-boot. La entrada tiene que estar
+ * dentro de la imagen. Retorna 0 o el MSG_xxx del error */
+static uint8_t mon_exe_check(const uint8_t *p, uint32_t avail) {
+    exe_hdr = *(const mon_exe_hdr_t *)p;
+    if (exe_hdr.format != MON_EXE_FORMAT ||
+        exe_hdr.flags != 0 ||
+        exe_hdr.len > avail ||
+        exe_hdr.load < USER_START ||
+        exe_hdr.entry < exe_hdr.load ||
+        exe_hdr.entry - exe_hdr.load >= exe_hdr.len ||
+        (uint32_t)exe_hdr.load + exe_hdr.len > STACK_START) {
+        return MSG_EXE_BAD;
+    }
+    if (exe_hdr.romapi > MON_ROMAPI_VER) {
+        return MSG_EXE_VER;
+    }
+    return 0;
+}
+
+/* Con la imagen ya en base: registrarla (last_base/last_len),
+ * verificar el CRC y dejar la entrada en last_addr (para R). Si el
+ * CRC falla, R no debe saltar a la imagen: last_addr vuelve al valor
+ * de arranque. Retorna la entrada o 0 */
+static uint16_t mon_exe_finish(uint16_t base) {
+    uint16_t entry;
+
+    last_base = base;
+    last_len = exe_hdr.len;
+    if (mem_crc32((const void *)base, exe_hdr.len) != exe_hdr.crc) {
+        last_addr = 0x0200;
+        mon_error(MSG_EXE_CRC);
+        return 0;
+    }
+    entry = exe_hdr.entry - exe_hdr.load + base;
+    mon_msg(MSG_ENTRY);
+    mon_print_hex16(entry);
     mon_newline();
+    last_addr = entry;
+    return entry;
 }
 
+static void mon_ucmd_drop(uint8_t lo, uint8_t hi);
+
 /**
  * Cargar archivo SD a memoria
- * LOAD nombre addr
+ * LOAD nombre [addr]
+ * Con cabecera de ejecutable la dirección y el tamaño salen de ella.
+ * MicroFS solo lee en secuencia: la primera
+ * lectura es justo la cabecera, para que el cuerpo empiece en la
+ * siguiente sin volver atrás
  */
-void mon_sd_load(const char *name, uint16_t addr) {
-    uint8_t r;
+uint16_t mon_sd_load(const char *name, uint16_t addr) {
     uint16_t loaded = 0;
     uint16_t chunk;
-    uint8_t buf[64];
-    uint16_t i;
-    uint16_t size;
+    uint16_t entry;
+    uint8_t buf[MON_EXE_HDR_SIZE];
+    uint8_t i;
+    uint32_t size;
     
+    exe_hdr.magic[0] = 0;
+    mon_fs_need();
     if (!fs_mounted) {
-        uart_puts("SD no montada");
-        mon_newline();
-        return;
+        mon_msg(MSG_NO_FS);
+        return 0;
     }
     
-    /* Abrir archivo */
-    r = mfs_open(name);
-    if (r != MFS_OK) {
-        uart_puts("No encontrado: ");
+    /* Resolver nombre en el índice y abrir */
+    if (mon_fs_open(name) != MFS_OK) {
+        mon_msg(MSG_NOT_FOUND);
+        uart_puts(": ");
         uart_puts(name);
         mon_newline();
-        return;
+        return 0;
+    }
+    
+    /* Tamaño desde el índice (32 bits) */
+    size = mon_fs_get_size32();
+    chunk = mfs_read(buf, MON_EXE_HDR_SIZE);
+    
+    if (chunk >= MON_EXE_HDR_SIZE && mon_exe_is_hdr(buf)) {
+        i = mon_exe_check(buf, size - MON_EXE_HDR_SIZE);
+        if (i) {
+            mon_fs_close();
+            mon_error(i);
+            return 0;
+        }
+        addr = exe_hdr.load;
+        size = exe_hdr.len;
+        chunk = 0;
+    } else {
+        if (!addr) addr = 0x0800;
+        if (size > 0x10000UL - addr) {
+            /* No cargar más allá de $FFFF */
+            size = 0x10000UL - addr;
+        }
     }
     
-    /* Obtener tamaño del archivo abierto */
-    size = mfs_get_size();
+    /* Los comandos registrados por lo que se pise dejan de valer */
+    if (size) {
+        mon_ucmd_drop((uint8_t)(addr >> 8),
+                      (uint8_t)((addr + (uint16_t)size - 1) >> 8));
+    }
     
-    uart_puts("Cargando ");
+    mon_msg(MSG_LOADING);
     uart_puts(name);
     uart_puts(" (");
     mon_print_dec(size);
-    uart_puts(" bytes) -> $");
+    mon_msg(MSG_LOADING_TO);
     mon_print_hex16(addr);
     mon_newline();
     
-    /* Leer en chunks */
+    /* Sin cabecera, lo ya leído es el comienzo del programa */
+    for (i = 0; i < chunk && loaded < size; i++) {
+        ((uint8_t *)addr)[loaded++] = buf[i];
+    }
+    
+    /* El resto directo a memoria, de a 1 KB (un punto por bloque) */
     while (loaded < size) {
-        chunk = mfs_read(buf, 64);
-        if (chunk == 0) break;
-        
-        /* Escribir a memoria */
-        for (i = 0; i < chunk; i++) {
-            mon_write_byte(addr + loaded + i, buf[i]);
-        }
-        
+        chunk = size - loaded > 0x400 ? 0x400 : (uint16_t)(size - loaded);
+        chunk = mfs_read((uint8_t *)addr + loaded, chunk);
+        if (!chunk) break;
         loaded += chunk;
-        
-        /* Mostrar progreso */
-        if ((loaded & 0x3FF) == 0) {
-            uart_putc('.');
-        }
+        uart_putc('.');
     }
     
-    mfs_close();
-    
     mon_newline();
-    uart_puts("OK: ");
+    mon_msg(MSG_OK);
     mon_print_dec(loaded);
-    uart_puts(" bytes en $");
+    mon_msg(MSG_BYTES_AT);
     mon_print_hex16(addr);
     uart_puts("-$");
     mon_print_hex16(addr + loaded - 1);
     mon_newline();
     
-    last_addr = addr;
+    last_base = addr;
+    last_len = loaded;
+    if (!exe_hdr.magic[0]) {
+        last_addr = addr;
+        mon_fs_close();
+        return addr;
+    }
+    
+    entry = mon_exe_finish(addr);
+    mon_fs_close();
+    return entry;
 }
 
 /**
@@ -755,226 +826,443 @@ static void mon_sd_delete(const char *name) {
     uint8_t r;
     
     if (!fs_mounted) {
-        uart_puts("SD no montada");
-        mon_newline();
+        mon_msg(MSG_NO_FS);
         return;
     }
     
-    r = mfs_delete(name);
+    r = mon_fs_delete(name);
     if (r == MFS_OK) {
-        uart_puts("Eliminado: ");
+        mon_msg(MSG_DELETED);
         uart_puts(name);
     } else {
-        uart_puts("Error: ");
+        mon_msg(MSG_ERROR);
         mon_print_hex8(r);
     }
     mon_newline();
 }
 
+/* mon_sd_cat: overlay CAT.OVL (overlays/src/cat.c) */
+
+/* Función auxiliar para obtener nombre de archivo (convierte a mayúsculas) */
+static const char* parse_filename(const char *str, char *name, uint8_t maxlen) {
+    uint8_t i = 0;
+    char c;
+    
+    /* Saltar espacios */
+    while (*str == ' ') str++;
+    
+    /* Copiar hasta espacio o fin, convertir a mayúsculas */
+    while (*str && *str != ' ' && i < maxlen - 1) {
+        c = *str++;
+        if (c >= 'a' && c <= 'z') c -= 32;  /* A mayúsculas */
+        name[i++] = c;
+    }
+    name[i] = '\0';
+    
+    return str;
+}
+
+/* ============================================
+ * OVERLAYS EN SD
+ * ============================================ */
+/* Comandos poco usados compilados aparte (overlays/) y guardados en la
+ * SD como CMD.OVL. Se cargan en MON_OVL_BASE cada vez que se invocan:
+ * no hay caché porque un programa de usuario puede haber pisado la
+ * ventana. La ventana es RAM de usuario: si el último LOAD/XRECV la
+ * ocupa, el overlay no se carga. El módulo usa la ROM API y el runtime
+ * en ROM ($BD00), y recibe el resto de la línea de comando. */
+typedef uint8_t (*ovl_entry_t)(const char *args);
+
+/* mon_overlay_run: no hay overlay con ese nombre */
+#define OVL_NONE    0xFF
+
 /**
- * Mostrar contenido de archivo (hexdump)
+ * Ejecutar NOMBRE.OVL si cmd empieza con una palabra de 3-8 caracteres que
+ * esté en la SD
+ * @param args Argumentos, o 0 para pasar el resto de cmd
+ * @return OVL_NONE si no hay overlay con ese nombre; si no MON_ERROR
+ *         cuando no se pudo cargar o el módulo retornó distinto de 0,
+ *         y MON_OK
  */
-static void mon_sd_cat(const char *name) {
-    uint8_t r;
-    uint8_t buf[16];
-    uint16_t total = 0;
-    uint16_t n;
+static uint8_t mon_overlay_run(const char *cmd, const char *args) {
+    uint8_t *win = (uint8_t *)MON_OVL_BASE;
+    char name[13];
+    const char *p;
+    uint8_t n;
+    uint8_t i, rc;
+    uint16_t size;
+
+    p = parse_filename(cmd, name, 9);
+    n = (uint8_t)(p - cmd);
+    if (n < 3 || (*p != ' ' && *p != '\0')) return OVL_NONE;
+    for (i = 0; i < 5; i++) name[n + i] = ".OVL"[i];
+
+    /* Se resuelve en el índice en RAM: un comando mal escrito solo
+     * llega a la SD si el directorio no cabe en él (dir_partial) */
+    if (!fs_mounted || mon_fs_open(name) != MFS_OK) return OVL_NONE;
+
+    /* Que quepa y no pise el programa cargado (last_len = 0: ninguno) */
+    rc = 0;
+    if (mon_fs_get_size32() > MON_OVL_SIZE) rc = MSG_OVL_BAD;
+    if (last_len && last_base < MON_OVL_BASE + MON_OVL_SIZE &&
+        last_base + (last_len - 1) >= MON_OVL_BASE) rc = MSG_OVL_BUSY;
+    if (rc) {
+        mon_fs_close();
+        mon_error(rc);
+        return MON_ERROR;
+    }
+    mon_ucmd_drop(MON_OVL_BASE >> 8, (MON_OVL_BASE + MON_OVL_SIZE - 1) >> 8);
+    size = mfs_read(win, MON_OVL_SIZE);
+    mon_fs_close();
+
+    if (size <= MON_OVL_ADDR + 1 || win[0] != 'O' || win[1] != 'V' ||
+        win[2] != MON_OVL_ABI) {
+        mon_error(MSG_OVL_BAD);
+        return MON_ERROR;
+    }
+
+    if (!args) {
+        args = p;
+        while (*args == ' ') args++;
+    }
+    *(uint16_t *)(MON_OVL_BASE + MON_OVL_ADDR) = last_addr;
+    rc = ((ovl_entry_t)(MON_OVL_BASE + MON_OVL_ENTRY))(args) ?
+         MON_ERROR : MON_OK;
+    last_addr = *(uint16_t *)(MON_OVL_BASE + MON_OVL_ADDR);
+    return rc;
+}
+
+/* ============================================
+ * AYUDA
+ * ============================================ */
+
+static void mon_help(void) {
+    mon_msg(MSG_HELP_HEAD);
+    uart_puts(VERSION);
+    mon_msg(MSG_HELP);
+}
+
+/* H cmd: overlay HELP.OVL (overlays/src/help.c) */
+
+/* ============================================
+ * TABLA DE COMANDOS
+ * ============================================ */
+/* Cada entrada indica qué argumentos parsea el despachador antes de
+ * llamar al manejador (arg_file, arg[], arg_rest), así el parseo no
+ * se repite en cada comando. */
+
+#define ARG_FILE    0x80        /* primer token: nombre de archivo */
+#define ARG_HEX     0x03        /* máscara: tokens hex de 16 bits (0-3) */
+
+static char arg_file[13];       /* 8.3 + null */
+static uint16_t arg[3];         /* 0 si falta */
+static uint8_t arg_n;           /* tokens hex presentes */
+static const char *arg_rest;    /* resto de la línea sin parsear */
+
+typedef struct {
+    const char *name;
+    uint8_t args;               /* ARG_FILE | n tokens hex */
+    void (*fn)(void);
+} mon_cmd_t;
+
+static void mon_parse_args(const char *p, uint8_t flags) {
+    const char *q;
     uint8_t i;
-    
-    if (!fs_mounted) {
-        uart_puts("SD no montada");
-        mon_newline();
-        return;
+
+    arg_file[0] = '\0';
+    if (flags & ARG_FILE) p = parse_filename(p, arg_file, 13);
+    arg_n = 0;
+    for (i = 0; i < (flags & ARG_HEX); i++) {
+        while (*p == ' ') p++;
+        q = parse_hex_token(p, &arg[i]);
+        if (q != p) arg_n = i + 1;
+        p = q;
     }
-    
-    r = mfs_open(name);
-    if (r != MFS_OK) {
-        uart_puts("No encontrado");
-        mon_newline();
-        return;
+    arg_rest = p;
+}
+
+static void cmd_save(void) {
+    if (arg_file[0] && arg[0] && arg[1]) {
+        mon_sd_save(arg_file, arg[0], arg[1]);
+    } else {
+        mon_error(MSG_USE_SAVE);
     }
-    
-    uart_puts("=== ");
-    uart_puts(name);
-    uart_puts(" ===");
+}
+
+static void cmd_load(void) {
+    if (arg_file[0]) {
+        mon_sd_load(arg_file, arg[0]);
+    } else {
+        mon_error(MSG_USE_LOAD);
+    }
+}
+
+static void cmd_del(void) {
+    if (arg_file[0]) {
+        mon_sd_delete(arg_file);
+    } else {
+        mon_error(MSG_USE_DEL);
+    }
+}
+
+/* SDFMT: overlay SDFMT.OVL (overlays/src/sdfmt.c) */
+
+static void cmd_xrecv(void) {
+    uint16_t addr = arg[0] ? arg[0] : 0x0800; /* después de BSS */
+    int bytes;
+    uint8_t r;
+    const uint8_t *src;
+    uint8_t *dst;
+    uint16_t n;
+
+    mon_msg(MSG_XRECV);
+    mon_print_hex16(addr);
     mon_newline();
-    
-    while (1) {
-        n = mfs_read(buf, 16);
-        if (n == 0) break;
-        
-        /* Dirección */
-        mon_print_hex16(total);
-        uart_puts(": ");
-        
-        /* Hex */
-        for (i = 0; i < n; i++) {
-            mon_print_hex8(buf[i]);
-            uart_putc(' ');
-        }
-        
-        /* Padding */
-        for (; i < 16; i++) {
-            uart_puts("   ");
-        }
-        
-        /* ASCII */
-        uart_putc('|');
-        for (i = 0; i < n; i++) {
-            if (buf[i] >= 0x20 && buf[i] < 0x7F) {
-                uart_putc(buf[i]);
+    mon_msg(MSG_XRECV_GO);
+
+    bytes = xmodem_receive(addr);
+
+    /* Pequeña pausa y limpiar buffer UART */
+    { unsigned int d; for(d=0; d<30000; d++); }
+    while(uart_rx_ready()) uart_getc();
+
+    mon_newline();
+    if (bytes > 0) {
+        mon_ucmd_drop((uint8_t)(addr >> 8),
+                      (uint8_t)((addr + (uint16_t)bytes - 1) >> 8));
+        mon_msg(MSG_OK);
+        mon_print_dec((unsigned int)bytes);
+        mon_msg(MSG_BYTES_AT);
+        mon_print_hex16(addr);
+        uart_puts("-$");
+        mon_print_hex16(addr + (unsigned int)bytes - 1);
+        last_base = addr;
+        last_len = (uint16_t)bytes;
+
+        /* Ejecutable con cabecera: mover el cuerpo a su dirección */
+        if (bytes >= MON_EXE_HDR_SIZE && mon_exe_is_hdr((const uint8_t *)addr)) {
+            mon_newline();
+            r = mon_exe_check((const uint8_t *)addr,
+                              (uint16_t)bytes - MON_EXE_HDR_SIZE);
+            if (r) {
+                last_addr = 0x0200;
+                mon_error(r);
+                return;
+            }
+            /* Hacia atrás si el destino queda por encima (solapados) */
+            src = (const uint8_t *)addr + MON_EXE_HDR_SIZE;
+            dst = (uint8_t *)exe_hdr.load;
+            n = exe_hdr.len;
+            if (dst <= src) {
+                while (n--) *dst++ = *src++;
             } else {
-                uart_putc('.');
+                while (n--) dst[n] = src[n];
             }
+            mon_ucmd_drop((uint8_t)(exe_hdr.load >> 8),
+                          (uint8_t)((exe_hdr.load + exe_hdr.len - 1) >> 8));
+            mon_exe_finish(exe_hdr.load);
+            return;
         }
-        uart_putc('|');
-        mon_newline();
-        
-        total += n;
-        
-        /* Limitar a 256 bytes en pantalla */
-        if (total >= 256) {
-            uart_puts("...(");
-            mon_print_dec(total);
-            uart_puts(" bytes mostrados)");
-            mon_newline();
-            break;
-        }
+        last_addr = addr;
+    } else {
+        mon_msg(MSG_XRECV_ERR);
+        mon_print_hex8((unsigned char)(-bytes));
     }
-    
-    mfs_close();
+    mon_newline();
 }
 
-/* ============================================
- * AYUDA
- * ============================================ */
+/* R [addr]: sin addr ejecuta en la última dirección usada (la
+ * entrada si lo último cargado fue un ejecutable con cabecera) */
+static void cmd_run(void) {
+    mon_execute(arg[0] ? arg[0] : last_addr);
+}
 
-/* Prototipo adelantado */
-static uint8_t cmd_match(const char *cmd, const char *pattern);
+/* RD [addr]: leer byte ("RD 0" lee $0000, "RD" sigue en last_addr) */
+static void cmd_rd(void) {
+    uint16_t addr = arg_n ? arg[0] : last_addr;
 
-static void mon_help(void) {
+    uart_putc('$');
+    mon_print_hex16(addr);
+    uart_puts(" = $");
+    mon_print_hex8(mon_read_byte(addr));
     mon_newline();
-    uart_puts("=== 6502 MONITOR " VERSION " ===\r\n");
-    uart_puts("H cmd=ayuda\r\n");
-    uart_puts("RD Leer\r\n");
-    uart_puts("W addr val Escribir\r\n");
-    uart_puts("D d len Dump hex\r\n");
-    uart_puts("L addr Carga hex\r\n");
-    uart_puts("R [addr] Run\r\n");
-    uart_puts("F d l v Fill\r\n");
-    uart_puts("M [n] Desensamblar\r\n");
-    uart_puts("XRECV [dir] XMODEM\r\n");
-    uart_puts("I Info mem\r\n");
-    uart_puts("SD: LS SAVE LOAD DEL CAT SDFMT\r\n");
-    uart_puts("Q Reset\r\n");
-}
-
-/* Ayuda detallada por comando (compacta para ahorrar ROM) */
-static void mon_help_cmd(char cmd) {
-    if (cmd >= 'a' && cmd <= 'z') cmd -= 32;
+    last_addr = addr + 1;
+}
+
+static void cmd_write(void) {
+    mon_write_byte(arg[0], (uint8_t)arg[1]);
+    uart_putc('$');
+    mon_print_hex16(arg[0]);
+    uart_puts(" <- $");
+    mon_print_hex8((uint8_t)arg[1]);
     mon_newline();
-    switch (cmd) {
-        case 'R':
-            uart_puts("R [dir] Run\r\n");
-            uart_puts("Dir default=$0800\r\n");
-            uart_puts("Terminar con RTS\r\n");
-            uart_puts("RD dir Leer byte\r\n");
-            break;
-        case 'W':
-            uart_puts("W dir val Escribir\r\n");
-            break;
-        case 'D':
-            uart_puts("D dir [n] Dump hex\r\n");
-            uart_puts("n default=64\r\n");
-            break;
-        case 'L':
-            uart_puts("L dir Carga hex int\r\n");
-            uart_puts("Escribe bytes, '.' fin\r\n");
-            break;
-        case 'F':
-            uart_puts("F dir n val Fill\r\n");
-            break;
-        case 'M':
-            uart_puts("M dir [n] Desensamblar\r\n");
-            uart_puts("n=instrucciones (def 16)\r\n");
-            break;
-        case 'I':
-            uart_puts("I - Info mapa memoria\r\n");
-            break;
-        case 'Q':
-            uart_puts("Q - Salir del monitor\r\n");
-            break;
-        default:
-            uart_puts("Cmd desconocido\r\n");
-            break;
-    }
+    last_addr = arg[0] + 1;
+}
+
+static void cmd_dump(void) {
+    mon_dump(arg[0], arg[1] ? arg[1] : 64);
 }
 
-/* Ayuda para comandos SD */
-static void mon_help_sd(const char *cmd) {
+static void cmd_fill(void) {
+    mon_fill(arg[0], arg[1], (uint8_t)arg[2]);
+    mon_msg(MSG_FILLED);
+    mon_print_hex16(arg[0]);
+    uart_puts("-$");
+    mon_print_hex16(arg[0] + arg[1] - 1);
+    mon_msg(MSG_WITH);
+    mon_print_hex8((uint8_t)arg[2]);
     mon_newline();
-    
-    if (cmd_match(cmd, "SD"))
-        uart_puts("SD - Inicializar SD\r\n");
-    else if (cmd_match(cmd, "LS"))
-        uart_puts("LS - Listar archivos\r\n");
-    else if (cmd_match(cmd, "SAVE"))
-        uart_puts("SAVE file dir n Guardar\r\n");
-    else if (cmd_match(cmd, "LOAD"))
-        uart_puts("LOAD file [dir] Cargar\r\n");
-    else if (cmd_match(cmd, "DEL"))
-        uart_puts("DEL file Eliminar\r\n");
-    else if (cmd_match(cmd, "CAT"))
-        uart_puts("CAT file Ver hex\r\n");
-    else if (cmd_match(cmd, "SDFMT"))
-        uart_puts("SDFMT Formatear SD\r\n");
-    else if (cmd_match(cmd, "XRECV"))
-        uart_puts("XRECV [dir] XMODEM\r\n");
-    else
-        uart_puts("SD: LS SAVE LOAD DEL CAT SDFMT\r\n");
+}
+
+/* Comandos de la ROM que atiende un overlay, con los argumentos tal
+ * como vienen (la dirección por omisión va en la cabecera) */
+static void mon_ovl_cmd(const char *name) {
+    if (mon_overlay_run(name, arg_rest) == OVL_NONE) {
+        mon_error(MSG_OVL_NONE);
+    }
+}
+
+static void cmd_hexload(void) {
+    mon_ovl_cmd("HEXLOAD");
+}
+
+static void cmd_disasm(void) {
+    mon_ovl_cmd("DISASM");
+}
+
+/* H: ayuda general; H cmd: la del comando (HELP.OVL) */
+static void cmd_help(void) {
+    while (*arg_rest == ' ') arg_rest++;
+    if (*arg_rest) {
+        mon_ovl_cmd("HELP");
+    } else {
+        mon_help();
+    }
+}
+
+static void cmd_quit(void) {
+    mon_msg(MSG_RESET);
+    soft_reset();
+}
+
+/* Ordenada por nombre (ASCII) para la búsqueda binaria. Los nombres
+ * de una letra admiten argumentos pegados ("D0800") */
+static const mon_cmd_t mon_cmds[] = {
+    { "?",      0,            cmd_help     },
+    { "D",      2,            cmd_dump     },
+    { "DEL",    ARG_FILE,     cmd_del      },
+    { "F",      3,            cmd_fill     },
+    { "H",      0,            cmd_help     },
+    { "I",      0,            mon_info     },
+    { "L",      0,            cmd_hexload  },
+    { "LOAD",   ARG_FILE | 1, cmd_load     },
+    { "LS",     0,            mon_sd_list  },
+    { "M",      0,            cmd_disasm   },
+    { "Q",      0,            cmd_quit     },
+    { "R",      1,            cmd_run      },
+    { "RD",     1,            cmd_rd       },
+    { "SAVE",   ARG_FILE | 2, cmd_save     },
+    { "SD",     0,            mon_sd_init  },
+    { "W",      2,            cmd_write    },
+    { "XRECV",  1,            cmd_xrecv    },
+};
+
+#define MON_NCMDS   (sizeof(mon_cmds) / sizeof(mon_cmds[0]))
+
+/* Comparar la primera palabra de cmd (hasta espacio o fin, sin
+ * distinguir mayúsculas) con name. Retorna <0, 0 o >0 como strcmp */
+static int8_t cmd_cmp(const char *cmd, const char *name) {
+    char c;
+
+    while (1) {
+        c = *cmd++;
+        if (c >= 'a' && c <= 'z') c -= 32;
+        if (c == ' ') c = '\0';
+        if (c != *name) return (uint8_t)c < (uint8_t)*name ? -1 : 1;
+        if (c == '\0') return 0;
+        name++;
+    }
+}
+
+static const mon_cmd_t *mon_cmd_find(const char *cmd) {
+    uint8_t lo = 0;
+    uint8_t hi = MON_NCMDS;
+    uint8_t mid;
+    int8_t r;
+
+    while (lo < hi) {
+        mid = (lo + hi) >> 1;
+        r = cmd_cmp(cmd, mon_cmds[mid].name);
+        if (r == 0) return &mon_cmds[mid];
+        if (r < 0) hi = mid; else lo = mid + 1;
+    }
+    return 0;
 }
 
 /* ============================================
- * PROCESAMIENTO DE COMANDOS
+ * COMANDOS DE USUARIO (ROM API cmd_register)
  * ============================================ */
+/* Lista enlazada de nodos en la RAM del programa residente: el
+ * monitor solo guarda la cabeza. Un nodo sin MON_UCMD_TAG (programa
+ * pisado por otro LOAD) vacía la lista en lugar de saltar a basura. */
+static mon_ucmd_t *ucmd_head;
 
-/* Función auxiliar para comparar comandos */
-static uint8_t cmd_match(const char *cmd, const char *pattern) {
-    while (*pattern) {
-        char c = *cmd;
-        if (c >= 'a' && c <= 'z') c -= 32;
-        if (c != *pattern) return 0;
-        cmd++;
-        pattern++;
+void mon_cmd_register(mon_ucmd_t *node) {
+    mon_ucmd_t *n;
+
+    if (!node) {
+        ucmd_head = 0;
+        return;
+    }
+    for (n = ucmd_head; n; n = n->next) {
+        if (n == node) return;          /* ya registrado */
     }
-    /* Verificar que termina en espacio o fin */
-    return (*cmd == ' ' || *cmd == '\0');
+    node->next = ucmd_head;
+    ucmd_head = node;
 }
 
-/* Función auxiliar para obtener nombre de archivo (convierte a mayúsculas) */
-static const char* parse_filename(const char *str, char *name, uint8_t maxlen) {
-    uint8_t i = 0;
-    char c;
-    
-    /* Saltar espacios */
-    while (*str == ' ') str++;
-    
-    /* Copiar hasta espacio o fin, convertir a mayúsculas */
-    while (*str && *str != ' ' && i < maxlen - 1) {
-        c = *str++;
-        if (c >= 'a' && c <= 'z') c -= 32;  /* A mayúsculas */
-        name[i++] = c;
+/* Quitar los nodos que vivan en las páginas lo..hi, ambas incluidas
+ * (programa liberado o a punto de pisarse). Inclusivo para que la
+ * página $FF no dé la vuelta a 0 */
+static void mon_ucmd_drop(uint8_t lo, uint8_t hi) {
+    mon_ucmd_t **pp = &ucmd_head;
+    uint8_t page;
+
+    /* Y las ranuras de la ROM API que atendía ese código */
+    mon_ext_drop(lo, hi);
+    while (*pp) {
+        if ((*pp)->tag != MON_UCMD_TAG) {
+            *pp = 0;
+            return;
+        }
+        page = (uint8_t)((uint16_t)*pp >> 8);
+        if (page >= lo && page <= hi) {
+            *pp = (*pp)->next;
+        } else {
+            pp = &(*pp)->next;
+        }
     }
-    name[i] = '\0';
-    
-    return str;
+}
+
+static mon_ucmd_t *mon_ucmd_find(const char *cmd) {
+    mon_ucmd_t *n;
+
+    for (n = ucmd_head; n; n = n->next) {
+        if (n->tag != MON_UCMD_TAG) {
+            ucmd_head = 0;
+            return 0;
+        }
+        if (cmd_cmp(cmd, n->name) == 0) return n;
+    }
+    return 0;
 }
 
 uint8_t monitor_process_cmd(char *cmd) {
-    char command;
-    const char *ptr;
-    uint16_t addr, len, val;
-    char filename[13];  /* 8.3 + null */
+    const mon_cmd_t *c;
+    mon_ucmd_t *u;
+    const char *args;
+    char letter[2];
+    uint8_t r;
     
     /* Saltar espacios iniciales */
     while (*cmd == ' ') cmd++;
@@ -982,250 +1270,41 @@ uint8_t monitor_process_cmd(char *cmd) {
     /* Comando vacío */
     if (*cmd == '\0') return MON_OK;
     
-    /* Comandos multi-caracter primero */
-    if (cmd_match(cmd, "SAVE")) {
-        ptr = cmd + 4;
-        ptr = parse_filename(ptr, filename, 13);
-        ptr = parse_hex_token(ptr, &addr);
-        ptr = parse_hex_token(ptr, &len);
-        if (filename[0] && addr && len) {
-            mon_sd_save(filename, addr, len);
-        } else {
-            mon_error("Uso: SAVE nombre addr len");
-        }
-        return MON_OK;
-    }
-    
-    if (cmd_match(cmd, "LOAD")) {
-        ptr = cmd + 4;
-        ptr = parse_filename(ptr, filename, 13);
-        ptr = parse_hex_token(ptr, &addr);
-        if (addr == 0) addr = 0x0800; /* Default address */
-        if (filename[0]) {
-            mon_sd_load(filename, addr);
-        } else {
-            mon_error("Uso: LOAD nombre [addr]");
-        }
-        return MON_OK;
-    }
+    /* Args: tras la primera palabra */
+    args = cmd;
+    while (*args && *args != ' ') args++;
     
-    if (cmd_match(cmd, "DEL")) {
-        ptr = cmd + 3;
-        ptr = parse_filename(ptr, filename, 13);
-        if (filename[0]) {
-            mon_sd_delete(filename);
-        } else {
-            mon_error("Uso: DEL nombre");
-        }
-        return MON_OK;
-    }
+    /* 1. Palabra completa en la tabla */
+    c = mon_cmd_find(cmd);
     
-    if (cmd_match(cmd, "CAT")) {
-        ptr = cmd + 3;
-        ptr = parse_filename(ptr, filename, 13);
-        if (filename[0]) {
-            mon_sd_cat(filename);
-        } else {
-            mon_error("Uso: CAT nombre");
+    if (!c) {
+        /* 2. Comandos registrados por programas residentes */
+        u = mon_ucmd_find(cmd);
+        if (u) {
+            while (*args == ' ') args++;
+            /* Nunca MON_EXIT: el programa no puede cerrar el monitor */
+            return u->fn(args) ? MON_ERROR : MON_OK;
         }
-        return MON_OK;
-    }
-    
-    if (cmd_match(cmd, "LS")) {
-        mon_sd_list();
-        return MON_OK;
-    }
-    
-    if (cmd_match(cmd, "SD")) {
-        mon_sd_init();
-        return MON_OK;
-    }
-    
-    if (cmd_match(cmd, "SDFMT")) {
-        uint8_t r;
-        uart_puts("Formateando SD...");
-        mon_newline();
-        r = mfs_format();
-        if (r == MFS_OK) {
-            uart_puts("OK: SD formateada");
-        } else {
-            uart_puts("Error: ");
-            mon_print_hex8(r);
-        }
-        mon_newline();
-        return MON_OK;
-    }
-    
-    if (cmd_match(cmd, "XRECV")) {
-        int bytes;
         
-        ptr = cmd + 5;
-        ptr = parse_hex_token(ptr, &addr);
-        if (addr == 0) addr = 0x0800; /* Default address (después de BSS) */
+        /* 3. Overlay en SD (antes que los de una letra: "RAMTEST"
+         *    no debe tomarse como 'R') */
+        r = mon_overlay_run(cmd, 0);
+        if (r != OVL_NONE) return r;
         
-        uart_puts("Listo para XMODEM en $");
-        mon_print_hex16(addr);
-        mon_newline();
-        uart_puts("Inicie transferencia...");
-        mon_newline();
-        
-        bytes = xmodem_receive(addr);
-        
-        /* Pequeña pausa y limpiar buffer UART */
-        { unsigned int d; for(d=0; d<30000; d++); }
-        while(uart_rx_ready()) uart_getc();
-        
-        if (bytes > 0) {
-            mon_newline();
-            uart_puts("OK: ");
-            mon_print_dec((unsigned int)bytes);
-            uart_puts(" bytes en $");
-            mon_print_hex16(addr);
-            uart_puts("-$");
-            mon_print_hex16(addr + (unsigned int)bytes - 1);
-            mon_newline();
-            last_addr = addr;
-        } else {
-            mon_newline();
-            uart_puts("Error XMODEM: ");
-            mon_print_hex8((unsigned char)(-bytes));
-            mon_newline();
-        }
-        return MON_OK;
-    }
-    
-    /* Obtener comando (primer carácter) */
-    command = *cmd;
-    if (command >= 'a' && command <= 'z') {
-        command -= 32; /* Convertir a mayúscula */
+        /* 4. Comando de una letra con argumentos pegados */
+        letter[0] = *cmd;
+        letter[1] = '\0';
+        c = mon_cmd_find(letter);
+        args = cmd + 1;
     }
     
-    ptr = cmd + 1;
-    
-    switch (command) {
-        case 'R': /* Run */
-            /* R sin addr = Run en última dirección usada */
-            if (*ptr == ' ' || *ptr == '\0') {
-                /* Solo R = ejecutar en last_addr */
-                parse_hex_token(ptr, &addr);
-                if (addr == 0) addr = last_addr;
-                mon_execute(addr);
-            } else if ((*ptr == 'D' || *ptr == 'd') && (*(ptr+1) == ' ' || *(ptr+1) == '\0')) {
-                /* RD = read byte */
-                ptr++;
-                ptr = parse_hex_token(ptr, &addr);
-                if (addr == 0 && ptr == cmd + 2) {
-                    addr = last_addr;
-                }
-                uart_putc('$');
-                mon_print_hex16(addr);
-                uart_puts(" = $");
-                mon_print_hex8(mon_read_byte(addr));
-                mon_newline();
-                last_addr = addr + 1;
-            } else {
-                /* R addr = ejecutar en addr */
-                ptr = parse_hex_token(ptr, &addr);
-                if (addr == 0) addr = last_addr;
-                mon_execute(addr);
-            }
-            break;
-            
-        case 'W': /* Write byte */
-            ptr = parse_hex_token(ptr, &addr);
-            ptr = parse_hex_token(ptr, &val);
-            mon_write_byte(addr, (uint8_t)val);
-            uart_putc('$');
-            mon_print_hex16(addr);
-            uart_puts(" <- $");
-            mon_print_hex8((uint8_t)val);
-            mon_newline();
-            last_addr = addr + 1;
-            break;
-            
-        case 'D': /* Dump */
-            ptr = parse_hex_token(ptr, &addr);
-            ptr = parse_hex_token(ptr, &len);
-            if (len == 0) len = 64; /* Default 64 bytes */
-            mon_dump(addr, len);
-            break;
-            
-        case 'L': /* Load mode */
-            ptr = parse_hex_token(ptr, &addr);
-            if (addr == 0) addr = last_addr;
-            mon_load_mode(addr);
-            break;
-            
-        case 'F': /* Fill */
-            ptr = parse_hex_token(ptr, &addr);
-            ptr = parse_hex_token(ptr, &len);
-            ptr = parse_hex_token(ptr, &val);
-            mon_fill(addr, len, (uint8_t)val);
-            uart_puts("Filled $");
-            mon_print_hex16(addr);
-            uart_puts("-$");
-            mon_print_hex16(addr + len - 1);
-            uart_puts(" con $");
-            mon_print_hex8((uint8_t)val);
-            mon_newline();
-            break;
-            
-        case 'M': /* Memory/Disassemble */
-            ptr = parse_hex_token(ptr, &addr);
-            if (addr == 0) addr = last_addr;
-            ptr = parse_hex_token(ptr, &len);
-            if (len == 0) len = 16;
-            if (len > 255) {
-                uart_puts("Max 255 (FF) lineas");
-                mon_newline();
-                len = 255;
-            }
-            mon_disassemble(addr, (uint8_t)len);
-            break;
-            
-        case 'I': /* Info - Mapa de memoria */
-            mon_info();
-            break;
-            
-        case 'S':
-        case 'T':
-        case 'V':
-            uart_puts("Cmd deshabilitado p/ XMODEM\r\n");
-            break;
-            
-        case 'Q': /* Reset */
-            uart_puts("Reset...");
-            mon_newline();
-            soft_reset();
-            break;
-            
-        case 'H':
-        case '?':
-            /* Saltar espacios después de H */
-            while (*ptr == ' ') ptr++;
-            
-            if (*ptr == '\0') {
-                /* H sin argumentos: ayuda general */
-                mon_help();
-            } else {
-                /* H con argumento: ayuda específica */
-                /* Verificar si es comando SD (multi-caracter) */
-                if (cmd_match(ptr, "SD") || cmd_match(ptr, "LS") ||
-                    cmd_match(ptr, "SAVE") || cmd_match(ptr, "LOAD") ||
-                    cmd_match(ptr, "DEL") || cmd_match(ptr, "CAT")) {
-                    mon_help_sd(ptr);
-                } else {
-                    /* Comando de un caracter */
-                    mon_help_cmd(*ptr);
-                }
-            }
-            break;
-            
-        default:
-            mon_error("Comando desconocido. H=ayuda");
-            break;
+    if (!c) {
+        mon_error(MSG_UNKNOWN);
+        return MON_OK;
     }
     
+    mon_parse_args(args, c->args);
+    c->fn();
     return MON_OK;
 }
 
@@ -1238,8 +1317,16 @@ static void mon_read_line(void) {
     input_pos = 0;
     
     while (1) {
+        while (!uart_rx_ready()) mon_idle();
         c = uart_getc();
         
+        /* Escape - cancelar línea */
+        if (c == 0x1B) {
+            input_pos = 0;
+            uart_puts(" [ESC]");
+            c = '\r';
+        }
+        
         /* Enter - fin de línea */
         if (c == '\r' || c == '\n') {
             input_buffer[input_pos] = '\0';
@@ -1258,15 +1345,6 @@ static void mon_read_line(void) {
             continue;
         }
         
-        /* Escape - cancelar línea */
-        if (c == 0x1B) {
-            input_pos = 0;
-            input_buffer[0] = '\0';
-            uart_puts(" [ESC]");
-            mon_newline();
-            return;
-        }
-        
         /* Carácter normal */
         if (input_pos < MON_BUFFER_SIZE - 1 && c >= 0x20 && c < 0x7F) {
             input_buffer[input_pos++] = c;
@@ -1276,56 +1354,110 @@ static void mon_read_line(void) {
 }
 
 /* ============================================
- * AUTO-BOOT desde SD (solo una vez, archivo BOOT.INI)
+ * AUTO-BOOT (solo una vez): BOOT.INI de la SD
  * ============================================ */
-/* Flag de 2 bytes al tope de RAM ($3FFE-$3FFF)
- * - Stack CC65 crece hacia ABAJO desde $3DFF, nunca toca $3E00+
+/* Flag de 2 bytes al tope de RAM ($3FFE-$3FFF) y, debajo, el registro
+ * de la imagen cargada ($3FF2-$3FFD). startup.s arranca el stack de
+ * CC65 en $3FF2, así que ni el monitor ni los programas los pisan.
  * - BASIC se carga en $0800, max $3DFF
- * - Ãšnico lugar que ningÃºn programa de usuario toca */
+ * Reset en caliente (flag puesto): si el programa del auto-boot seguía
+ * en RAM (AUTOBOOT_WARM) y su CRC-16 coincide, se salta a él sin tocar
+ * la SD (se monta si el programa la pide, ver mon_fs_need); si no
+ * coincide se recarga. Si el programa volvió al monitor el registro se
+ * borra y un Q no vuelve a bootear. */
 #define AUTOBOOT_MAGIC  0xA5
 #define AUTOBOOT_FLAG_LO ((volatile uint8_t*)0x3FFE)
 #define AUTOBOOT_FLAG_HI ((volatile uint8_t*)0x3FFF)
+#define AUTOBOOT_REC    ((volatile uint8_t*)0x3FF2)
+#define AUTOBOOT_ADDR   (*(volatile uint16_t*)0x3FF2)
+#define AUTOBOOT_ENTRY  (*(volatile uint16_t*)0x3FF4)
+#define AUTOBOOT_LEN    (*(volatile uint16_t*)0x3FF6)
+#define AUTOBOOT_CRC    (*(volatile uint16_t*)0x3FF8)   /* $3FFA-$3FFB libres */
+#define AUTOBOOT_WARM   (*(volatile uint8_t*)0x3FFC)
+#define AUTOBOOT_CHK    (*(volatile uint8_t*)0x3FFD)
 
-static void mon_try_autoboot(void) {
+/* Byte de control del registro: evita fiarse de RAM aleatoria */
+static uint8_t mon_boot_chk(void) {
     uint8_t i;
-    char bootname[13];
-    uint16_t n;
-    uint8_t lo, hi;
-    
-    /* Leer flag */
-    lo = *AUTOBOOT_FLAG_LO;
-    hi = *AUTOBOOT_FLAG_HI;
-    if (lo == AUTOBOOT_MAGIC && hi == AUTOBOOT_MAGIC)
-        return;
-    
+    uint8_t c = AUTOBOOT_MAGIC;
+
+    for (i = 0; i < 10; i++) {
+        c ^= AUTOBOOT_REC[i];
+    }
+    return c;
+}
+
+/* Ejecutar la imagen con el registro activo mientras corre */
+static void mon_boot_exec(void) {
+    AUTOBOOT_WARM = AUTOBOOT_MAGIC;
+    boot_t[BOOT_T_RUN] = get_micros();
+    mon_execute(AUTOBOOT_ENTRY);
+    AUTOBOOT_WARM = 0;
+}
+
+/* Registrar la imagen recién cargada para el reset en caliente y
+ * ejecutarla. CRC-16 y no el CRC-32 de la cabecera X65: el reset en
+ * caliente lo recalcula y el CRC-32 es 4,7 veces más lento */
+static void mon_boot_run(uint16_t entry) {
+    AUTOBOOT_ADDR = last_base;
+    AUTOBOOT_ENTRY = entry;
+    AUTOBOOT_LEN = last_len;
+    AUTOBOOT_CRC = mem_crc16((const void *)last_base, last_len);
+    AUTOBOOT_CHK = mon_boot_chk();
+    mon_boot_exec();
+}
+
+/* Reset en caliente (antes de tocar la SD): relanzar el programa si
+ * seguía corriendo. Con 13,5 KB el CRC-16 tarda ~0,31 s (77 ciclos por
+ * byte a 3,375 MHz); el CRC-32 tardaba 1,5 s.
+ * Retorna 1 solo si toca el auto-boot en frío (deja el flag puesto) */
+static uint8_t mon_boot_cold(void) {
+    if (*AUTOBOOT_FLAG_LO == AUTOBOOT_MAGIC &&
+        *AUTOBOOT_FLAG_HI == AUTOBOOT_MAGIC) {
+        /* Solo si el programa seguía corriendo. Una tecla pendiente
+         * en la UART fuerza el monitor */
+        if (AUTOBOOT_WARM != AUTOBOOT_MAGIC || AUTOBOOT_CHK != mon_boot_chk()
+            || uart_rx_ready())
+            return 0;
+        if (mem_crc16((const void *)AUTOBOOT_ADDR, AUTOBOOT_LEN) == AUTOBOOT_CRC) {
+            /* Como tras un LOAD: R, D y los overlays saben qué hay */
+            last_addr = AUTOBOOT_ENTRY;
+            last_base = AUTOBOOT_ADDR;
+            last_len = AUTOBOOT_LEN;
+            fs_lazy = 1;
+            mon_boot_exec();
+            fs_lazy = 0;
+            return 0;
+        }
+    }
     *AUTOBOOT_FLAG_LO = AUTOBOOT_MAGIC;
     *AUTOBOOT_FLAG_HI = AUTOBOOT_MAGIC;
-    
-    /* Buscar BOOT.INI (probar mayÃºsculas y minÃºsculas) */
-    bootname[0]='B'; bootname[1]='O'; bootname[2]='O'; bootname[3]='T';
-    bootname[4]='.'; bootname[5]='I'; bootname[6]='N'; bootname[7]='I';
-    bootname[8]='\0';
-    if (mfs_open(bootname) != MFS_OK) {
-        bootname[0]='b'; bootname[1]='o'; bootname[2]='o'; bootname[3]='t';
-        bootname[4]='.'; bootname[5]='i'; bootname[6]='n'; bootname[7]='i';
-        if (mfs_open(bootname) != MFS_OK) return;
-    }
-    
+    AUTOBOOT_WARM = 0;
+    return 1;
+}
+
+/* Auto-boot desde la SD: el programa que nombra BOOT.INI */
+static void mon_try_autoboot(void) {
+    char bootname[13];
+    uint16_t n;
+    uint16_t entry;
+
+    /* Buscar BOOT.INI en el índice (sin distinguir mayúsculas) */
+    if (mon_fs_open("BOOT.INI") != MFS_OK) return;
+
     /* Leer nombre del archivo a bootear */
     n = mfs_read(bootname, 12);
-    mfs_close();
-    
-    /* Limpiar y mayusculas */
+    mon_fs_close();
+
+    /* Limpiar (el índice no distingue mayúsculas) */
     bootname[n] = '\0';
     while (n && bootname[n-1] <= ' ') bootname[--n] = '\0';
     if (n == 0) return;
-    for (i = 0; i < n; i++)
-        if (bootname[i] >= 'a' && bootname[i] <= 'z') bootname[i] -= 32;
-    
-    /* Cargar en $0800 */
-    mon_sd_load(bootname, 0x0800);
-    if (last_addr == 0x0800)
-        mon_execute(0x0800);
+
+    /* Cargar (en $0800 si no tiene cabecera) y registrar la imagen
+     * para el reset en caliente */
+    entry = mon_sd_load(bootname, 0);
+    if (entry) mon_boot_run(entry);
 }
 
 /* ============================================
@@ -1335,32 +1467,40 @@ static void mon_try_autoboot(void) {
 void monitor_init(void) {
     input_pos = 0;
     last_addr = 0x0200;
+    mon_ext_reset();
+    boot_t[BOOT_T_MAIN] = get_micros();
 }
 
 void monitor_run(void) {
     uint8_t result;
+    uint8_t boot;
     
     /* Apagar LEDs al iniciar */
     LEDS = 0xFF;
     
     mon_newline();
-    uart_puts("--- Monitor 6502 ");
+    mon_msg(MSG_BANNER);
     uart_puts(VERSION);
-    uart_puts(" ---");
-    mon_newline();
-    uart_puts("H=ayuda, SD=SD Card, Q=reset");
+    mon_msg(MSG_BANNER_TAIL);
     
-    /* Montar SD automáticamente */
-    mon_newline();
-    mon_sd_init();
+    /* Reset en caliente: relanzar sin tocar la SD */
+    boot = mon_boot_cold();
     
-    /* Pequeña pausa para que SD se estabilice */
-    { volatile uint16_t d; for(d=0; d<30000; d++); }
+    /* Montar SD automáticamente (si el programa relanzado no lo hizo) */
+    if (!fs_mounted) mon_sd_init();
+    
+    /* Esperar a que la SD termine (en vez de una pausa fija) */
+    if (sd_initialized) {
+        uint32_t t0 = get_micros();
+        while (!sd_is_ready() && get_micros() - t0 < MON_SD_READY_US);
+    }
+    if (!boot_t[BOOT_T_SD]) boot_t[BOOT_T_SD] = get_micros();
     
     /* Intentar auto-boot si hay BOOT.INI */
-    mon_try_autoboot();
+    if (boot) mon_try_autoboot();
     
     while (1) {
+        if (!boot_t[BOOT_T_PROMPT]) boot_t[BOOT_T_PROMPT] = get_micros();
         mon_prompt();
         mon_read_line();
         
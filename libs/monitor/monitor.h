@@ -35,6 +35,92 @@
 /* Estructura para pasar código a ejecutar */
 typedef void (*code_ptr)(void);
 
+/* Máximo de archivos en el índice de directorio en RAM */
+#define MON_DIR_MAX      32
+
+/* Ventana de overlays: comandos poco usados que se cargan de la SD
+ * (NOMBRE.OVL, ver overlays/) al invocarlos. Cabecera del módulo:
+ * "OV", versión ABI, JMP a uint8_t entry(const char *args) y la
+ * dirección actual del monitor (la de R, D, M o L sin dirección):
+ * el monitor la escribe antes de llamar y la recoge al volver */
+#define MON_OVL_BASE     0x3600
+#define MON_OVL_SIZE     0x0800
+#define MON_OVL_ABI      2
+#define MON_OVL_ENTRY    3      /* offset del JMP en la cabecera */
+#define MON_OVL_ADDR     6      /* offset de la dirección actual */
+
+/* Marcas de tiempo del arranque (µs desde reset, 0 = no alcanzada).
+ * El comando I las muestra; orden de MSG_T_MAIN.. en mon_text.txt */
+#define BOOT_T_MAIN      0      /* monitor_init: startup + main */
+#define BOOT_T_SD        1      /* SD inicializada y montada */
+#define BOOT_T_RUN       2      /* antes de ejecutar el auto-boot */
+#define BOOT_T_PROMPT    3      /* primer prompt */
+#define BOOT_T_COUNT     4
+
+/* Espera máxima a que la SD quede libre antes del auto-boot */
+#define MON_SD_READY_US  250000UL
+
+/* Comando registrado por un programa residente (ROM API
+ * cmd_register). El nodo vive en la RAM del programa; name en
+ * mayúsculas, fn recibe el resto de la línea y retorna MON_OK (0);
+ * cualquier otro valor cuenta como MON_ERROR */
+#define MON_UCMD_TAG     0xC5
+
+typedef struct mon_ucmd {
+    struct mon_ucmd *next;  /* lo rellena el monitor */
+    const char *name;
+    uint8_t (*fn)(const char *args);
+    uint8_t tag;            /* MON_UCMD_TAG */
+} mon_ucmd_t;
+
+/* Cabecera opcional de ejecutable (scripts/mkexe.py). LOAD, XRECV,
+ * R, el auto-boot y $BF7E/$BF81 la reconocen; los binarios sin
+ * cabecera se cargan como siempre en la dirección pedida */
+#define MON_EXE_MAGIC0   'X'
+#define MON_EXE_MAGIC1   '6'
+#define MON_EXE_MAGIC2   '5'
+#define MON_EXE_FORMAT   1
+#define MON_EXE_HDR_SIZE 16
+
+typedef struct {
+    char     magic[3];      /* "X65" */
+    uint8_t  format;        /* MON_EXE_FORMAT */
+    uint8_t  romapi;        /* versión mínima (major<<4 | minor), 0 = any */
+    uint8_t  flags;         /* reservado, 0 */
+    uint16_t load;          /* dirección de carga */
+    uint16_t entry;         /* punto de entrada */
+    uint16_t len;           /* bytes del programa */
+    uint32_t crc;           /* CRC-32 (zlib) del programa */
+} mon_exe_hdr_t;
+
+/* Versión de la ROM API ($BF8A) */
+#define MON_ROMAPI_VER   (*(const uint8_t *)0xBF8A)
+
+/* mon_fs_list: el directorio tiene más archivos que el índice y las
+ * entradas desde dir_count no se pueden listar desde la RAM */
+#define MON_FS_PARTIAL   0x10
+
+/* Entrada del índice de directorio. El campo es de 32 bits para la ROM
+ * API, pero MicroFS guarda tamaños de 16 bits (mfs_fileinfo_t.size) */
+typedef struct {
+    char     name[13];      /* 12 chars + null */
+    uint32_t size;
+} mon_fileinfo_t;
+
+/* Contadores de errores y actividad (STATS.OVL, ROM API stats_read).
+ * En el BSS de romapi.s, a cero en cada arranque. De 16 bits, dan la
+ * vuelta; el bloque solo crece por el final. Los overlays DDR/DDW
+ * suman dd_retry a través de stats_read */
+typedef struct {
+    uint16_t xm_nak;        /* bloques XMODEM rechazados (NAK) */
+    uint16_t xm_timeout;    /* recepciones XMODEM cortadas sin EOT */
+    uint16_t dir_hit;       /* nombres hallados en el índice de directorio */
+    uint16_t dir_miss;      /* nombres fuera del índice */
+    uint16_t dd_retry;      /* tramas DDR/DDW reenviadas */
+} mon_stats_t;
+
+extern mon_stats_t mon_stats;
+
 /* ============================================
  * FUNCIONES PRINCIPALES
  * ============================================ */
@@ -57,6 +143,13 @@ void monitor_run(void);
  */
 uint8_t monitor_process_cmd(char *cmd);
 
+/**
+ * Registrar un comando de usuario (se busca después de los del
+ * monitor y antes que los overlays)
+ * @param node Nodo en RAM del programa, o NULL para borrar la lista
+ */
+void mon_cmd_register(mon_ucmd_t *node);
+
 /* ============================================
  * FUNCIONES DE MEMORIA
  * ============================================ */
@@ -85,16 +178,6 @@ void mon_fill(uint16_t addr, uint16_t len, uint8_t value);
  * FUNCIONES DE UTILIDAD
  * ============================================ */
 
-/**
- * Convertir cadena hex a uint16
- */
-uint16_t mon_hex_to_u16(const char *str);
-
-/**
- * Convertir cadena hex a uint8
- */
-uint8_t mon_hex_to_u8(const char *str);
-
 /**
  * Imprimir byte en hexadecimal
  */
@@ -118,8 +201,69 @@ void mon_execute(uint16_t addr);
 /**
  * Cargar archivo SD a memoria
  * @param name Nombre del archivo
- * @param addr Dirección de carga
+ * @param addr Dirección de carga sin cabecera (0 = $0800); con
+ *             cabecera se usa el load del ejecutable
+ * @return Punto de entrada (addr sin cabecera), 0 si falla
+ */
+uint16_t mon_sd_load(const char *name, uint16_t addr);
+
+/* ============================================
+ * MICROFS CON ÍNDICE EN RAM
+ * ============================================
+ * Envuelven a mfs_mount/format/create/delete y mantienen el
+ * índice de directorio del monitor sincronizado con la SD.
+ * La ROM API usa estas funciones en lugar de las de MicroFS. */
+
+/**
+ * Montar MicroFS y cargar el índice de directorio
+ * @return MFS_OK o código de error de MicroFS
+ */
+uint8_t mon_fs_mount(void);
+
+/**
+ * Formatear la SD y vaciar el índice
+ */
+uint8_t mon_fs_format(void);
+
+/**
+ * Crear archivo (queda abierto para mfs_write) y añadirlo al índice
+ */
+uint8_t mon_fs_create(const char *name, uint16_t size);
+
+/**
+ * Eliminar archivo. Si no está en el índice no accede a la SD
+ * @return MFS_OK, MFS_ERR_NOTFOUND o error de MicroFS
+ */
+uint8_t mon_fs_delete(const char *name);
+
+/**
+ * Abrir archivo resolviendo el nombre en el índice (sin distinguir
+ * mayúsculas). Solo busca en la SD si el directorio no cabe en el índice
+ */
+uint8_t mon_fs_open(const char *name);
+
+/**
+ * Cerrar el archivo abierto y olvidar su entrada del índice
+ */
+void mon_fs_close(void);
+
+/**
+ * Tamaño del archivo abierto con mon_fs_open, ampliado a 32 bits para
+ * la ROM API (MicroFS no pasa de 16 bits)
+ */
+uint32_t mon_fs_get_size32(void);
+
+/**
+ * Leer entrada del índice
+ * @param index Posición 0..n-1 (densa, sin huecos)
+ * @return MFS_OK, MFS_ERR_NOTFOUND al pasar del final o MON_FS_PARTIAL
+ *         si quedan archivos fuera del índice
+ */
+uint8_t mon_fs_list(uint16_t index, mon_fileinfo_t *info);
+
+/**
+ * mon_fs_list para la ROM API: index en $F4-$F5, info en $F6-$F7
  */
-void mon_sd_load(const char *name, uint16_t addr);
+uint8_t mon_fs_list_zp(void);
 
 #endif /* MONITOR_H */
@@ -0,0 +1,275 @@
+;; ===========================================================================
+;; ALLOC.S - Módulo residente: arena y pools de bloques fijos
+;; ===========================================================================
+;;
+;; Atiende las ranuras ALLOC de la ROM API ($BE39-$BE4B). Asignadores
+;; sobre una región que aporta el programa (RAM de usuario, fuera de las
+;; páginas de los módulos). El estado vive en la propia región, así que
+;; puede haber varias arenas y pools a la vez y el módulo no reserva nada:
+;;
+;;   arena   +0 siguiente libre, +2 fin (excluido), datos desde +4
+;;           Asignación por avance de puntero; mark/release libera de
+;;           golpe todo lo asignado después de la marca
+;;   pool    +0 cabeza de la lista libre, bloques desde +2
+;;           Cada bloque libre guarda en sus 2 primeros bytes el
+;;           siguiente: alloc y free son O(1), sin cabeceras por bloque
+;;
+;; Parámetros en ZP fijo, como el resto del bloque v3 (por la dirección
+;; de la ROM):
+;;
+;;   arena_init    $F0-$F1 = región, $F2-$F3 = tamaño (>= 4)
+;;                 Retorna A/X = bytes asignables
+;;   arena_alloc   $F0-$F1 = arena, $F2-$F3 = n
+;;                 Retorna A/X = puntero, 0 si no cabe. Usa $F4-$F7
+;;   arena_mark    $F0-$F1 = arena. Retorna A/X = marca
+;;   arena_release $F0-$F1 = arena, $F2-$F3 = marca (0 = vaciar)
+;;   pool_init     $F0-$F1 = región, $F2-$F3 = tamaño,
+;;                 $F4-$F5 = tamaño de bloque (>= 2)
+;;                 Retorna A/X = bloques. Usa $F6-$F7
+;;   pool_alloc    $F0-$F1 = pool. Retorna A/X = bloque, 0 si agotado
+;;   pool_free     $F0-$F1 = pool, $F2-$F3 = bloque (0 se ignora)
+;;
+;; Sin comprobaciones de doble free ni de bloques ajenos: el coste es
+;; el de unas pocas instrucciones, que es la razón de no usar malloc.
+;; ===========================================================================
+
+.include "module.inc"
+
+.export mod_setup, mod_desc
+
+.importzp ptr1, ptr2, tmp1, tmp2
+
+ARENA_HDR = 4
+POOL_HDR  = 2
+
+.segment "RODATA"
+
+mod_desc:
+    .byte X_ALLOC, 7
+    .word arena_init, arena_alloc, arena_mark, arena_release
+    .word pool_init, pool_alloc, pool_free
+
+.segment "CODE"
+
+mod_setup:
+    rts
+
+; ---------------------------------------------------------------------------
+; arena_init
+; ---------------------------------------------------------------------------
+arena_init:
+    ldy     #2              ; fin = región + tamaño
+    lda     $F0
+    clc
+    adc     $F2
+    sta     ($F0),y
+    iny
+    lda     $F1
+    adc     $F3
+    sta     ($F0),y
+    lda     $F2             ; retorno: tamaño - cabecera
+    sec
+    sbc     #ARENA_HDR
+    pha
+    lda     $F3
+    sbc     #0
+    tax                     ; arena_release no toca X
+    lda     #0              ; siguiente = primer byte de datos
+    sta     $F2
+    sta     $F3
+    jsr     arena_release
+    pla
+    rts
+
+; ---------------------------------------------------------------------------
+; arena_alloc - nuevo = siguiente + n; falla si pasa de fin o de $FFFF
+; ---------------------------------------------------------------------------
+arena_alloc:
+    ldy     #0
+    lda     ($F0),y
+    sta     $F4
+    clc
+    adc     $F2
+    sta     $F6
+    iny
+    lda     ($F0),y
+    sta     $F5
+    adc     $F3
+    sta     $F7
+    bcs     al_fail
+    ldy     #2              ; fin >= nuevo
+    lda     ($F0),y
+    cmp     $F6
+    iny
+    lda     ($F0),y
+    sbc     $F7
+    bcc     al_fail
+    ldy     #0
+    lda     $F6
+    sta     ($F0),y
+    iny
+    lda     $F7
+    sta     ($F0),y
+    lda     $F4
+    ldx     $F5
+    rts
+al_fail:
+    lda     #0
+    tax
+    rts
+
+; ---------------------------------------------------------------------------
+; arena_mark
+; ---------------------------------------------------------------------------
+arena_mark:
+    ldy     #1
+    lda     ($F0),y
+    tax
+    dey
+    lda     ($F0),y
+    rts
+
+; ---------------------------------------------------------------------------
+; arena_release - marca 0: volver al primer byte de datos
+; ---------------------------------------------------------------------------
+arena_release:
+    lda     $F2
+    ora     $F3
+    bne     @set
+    lda     $F0
+    clc
+    adc     #ARENA_HDR
+    sta     $F2
+    lda     $F1
+    adc     #0
+    sta     $F3
+@set:
+    ldy     #0
+    lda     $F2
+    sta     ($F0),y
+    iny
+    lda     $F3
+    sta     ($F0),y
+    rts
+
+; ---------------------------------------------------------------------------
+; pool_init - encadena los bloques en orden de dirección
+; ptr1 = enlace a rellenar, $F2 = bloque actual, ptr2 = el siguiente,
+; $F6 = fin, tmp1/tmp2 = bloques
+; ---------------------------------------------------------------------------
+pool_init:
+    lda     $F0
+    sta     ptr1
+    clc
+    adc     $F2
+    sta     $F6
+    lda     $F1
+    sta     ptr1+1
+    adc     $F3
+    sta     $F7
+    bcc     :+
+    lda     #$FF            ; región hasta $FFFF
+    sta     $F6
+    sta     $F7
+:   lda     $F0
+    clc
+    adc     #POOL_HDR
+    sta     $F2
+    lda     $F1
+    adc     #0
+    sta     $F3
+    lda     #0
+    sta     tmp1
+    sta     tmp2
+    lda     $F5             ; bloques de menos de 2 bytes: no caben
+    bne     @loop           ; los enlaces
+    lda     $F4
+    cmp     #POOL_HDR
+    bcc     @done
+
+@loop:
+    lda     $F2             ; siguiente = actual + tamaño de bloque
+    clc
+    adc     $F4
+    sta     ptr2
+    lda     $F3
+    adc     $F5
+    sta     ptr2+1
+    bcs     @done
+    lda     $F6             ; fin >= siguiente: el actual cabe
+    cmp     ptr2
+    lda     $F7
+    sbc     ptr2+1
+    bcc     @done
+    ldy     #0              ; enlace = actual; el actual pasa a
+    lda     $F2             ; ser el enlace a rellenar
+    sta     (ptr1),y
+    iny
+    lda     $F3
+    sta     (ptr1),y
+    sta     ptr1+1
+    lda     $F2
+    sta     ptr1
+    lda     ptr2
+    sta     $F2
+    lda     ptr2+1
+    sta     $F3
+    inc     tmp1
+    bne     @loop
+    inc     tmp2
+    jmp     @loop
+
+@done:
+    lda     #0              ; cerrar la lista
+    tay
+    sta     (ptr1),y
+    iny
+    sta     (ptr1),y
+    lda     tmp1
+    ldx     tmp2
+    rts
+
+; ---------------------------------------------------------------------------
+; pool_alloc - sacar la cabeza de la lista libre
+; ---------------------------------------------------------------------------
+pool_alloc:
+    ldy     #0
+    lda     ($F0),y
+    sta     ptr1
+    iny
+    lda     ($F0),y
+    sta     ptr1+1
+    ora     ptr1
+    beq     @empty          ; A = 0
+    lda     (ptr1),y        ; cabeza = bloque->siguiente
+    sta     ($F0),y
+    dey
+    lda     (ptr1),y
+    sta     ($F0),y
+    lda     ptr1
+    ldx     ptr1+1
+    rts
+@empty:
+    tax
+    rts
+
+; ---------------------------------------------------------------------------
+; pool_free - el bloque pasa a ser la cabeza
+; ---------------------------------------------------------------------------
+pool_free:
+    lda     $F2
+    ora     $F3
+    beq     @done
+    ldy     #0
+    lda     ($F0),y
+    sta     ($F2),y
+    iny
+    lda     ($F0),y
+    sta     ($F2),y
+    lda     $F3
+    sta     ($F0),y
+    dey
+    lda     $F2
+    sta     ($F0),y
+@done:
+    rts
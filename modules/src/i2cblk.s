@@ -0,0 +1,266 @@
+;; ===========================================================================
+;; I2CBLK.S - Módulo residente: transferencias I2C en bloque
+;; ===========================================================================
+;;
+;; Atiende las ranuras BUSBLK+1..2 de la ROM API ($BE60 i2c_write_buf,
+;; $BE63 i2c_read_buf); la BUSBLK+0 (spi_xfer_buf) es del módulo SPIBLK.
+;; i2c_write ($BF6C) e i2c_read ($BF6F) toman sus parámetros del stack de
+;; CC65, así que un programa externo acababa haciendo un JSR a la ROM por
+;; byte con i2c_write_byte/i2c_read_byte. Estas entradas mueven el bloque
+;; entero en un bucle en ensamblador sobre las primitivas I2C de la ROM,
+;; con los parámetros en ZP fijo como el resto del bloque v3:
+;;
+;;   $F0-$F1 = buffer, $F2-$F3 = longitud
+;;   $F4     = dispositivo (7 bits)
+;;   $F5     = bytes de dirección interna (0, 1 o 2; 2 = big-endian)
+;;   $F6-$F7 = dirección interna (memoria/registro)
+;;
+;;   i2c_write_buf  A = tamaño de página EEPROM (potencia de 2, 0 = sin
+;;                  páginas). Con páginas, el bloque se parte en
+;;                  escrituras que no cruzan página, cada una con su
+;;                  dirección, y tras cada STOP espera con ACK polling a
+;;                  que la EEPROM termine el ciclo interno de grabación
+;;   i2c_read_buf   escribe la dirección (si $F5 > 0), START repetido y
+;;                  lee con ACK salvo el último byte (NACK)
+;;
+;; Ambas retornan A/X = bytes transferidos (< longitud si hubo NACK) y
+;; dejan $F0, $F2 y $F6 avanzados, de modo que una segunda llamada
+;; continúa donde se quedó la primera.
+;; ===========================================================================
+
+.include "module.inc"
+
+.export mod_setup, mod_desc
+
+.import pusha
+
+I2C_WRITE   = 0
+I2C_READ    = 1
+ACK_TRIES   = 0                 ; 256 intentos de ACK polling (> 5 ms)
+
+.segment "RODATA"
+
+mod_desc:
+    .byte X_BUSBLK + 1, 2
+    .word i2c_write_buf, i2c_read_buf
+
+.segment "BSS"
+ib_page:    .res 1              ; tamaño de página, 0 = sin páginas
+ib_cnt:     .res 2              ; bytes de la escritura en curso
+ib_done:    .res 2              ; bytes transferidos
+ib_try:     .res 1
+
+.segment "CODE"
+
+mod_setup:
+    rts
+
+; ---------------------------------------------------------------------------
+; ib_start - START al dispositivo de $F4 (A = I2C_WRITE/I2C_READ)
+; Retorna A = 0 si no hay ACK (Z según A)
+; ---------------------------------------------------------------------------
+ib_start:
+    pha
+    lda     $F4
+    jsr     pusha
+    pla
+    jsr     ROM_I2C_START
+    cmp     #0
+    rts
+
+; ---------------------------------------------------------------------------
+; ib_addr - START de escritura y dirección interna de $F5 bytes
+; Retorna C = 1 si el dispositivo no respondió (ya con STOP)
+; ---------------------------------------------------------------------------
+ib_addr:
+    lda     #I2C_WRITE
+    jsr     ib_start
+    beq     @nack
+    lda     $F5
+    cmp     #2
+    bcc     @lo
+    lda     $F7
+    jsr     ROM_I2C_WRITE_BYTE
+    cmp     #0
+    beq     @nack
+@lo:
+    lda     $F5
+    beq     @ok
+    lda     $F6
+    jsr     ROM_I2C_WRITE_BYTE
+    cmp     #0
+    beq     @nack
+@ok:
+    clc
+    rts
+@nack:
+    jsr     ROM_I2C_STOP
+    sec
+    rts
+
+; ---------------------------------------------------------------------------
+; ib_step - Un byte hecho: avanzar buffer y dirección, descontar longitud
+; ---------------------------------------------------------------------------
+ib_step:
+    inc     $F0
+    bne     :+
+    inc     $F1
+:   inc     $F6
+    bne     :+
+    inc     $F7
+:   lda     $F2
+    bne     :+
+    dec     $F3
+:   dec     $F2
+    inc     ib_done
+    bne     :+
+    inc     ib_done+1
+:   rts
+
+; ---------------------------------------------------------------------------
+; wb_len - ib_cnt = longitud, recortada al hueco hasta el fin de página
+; ---------------------------------------------------------------------------
+wb_len:
+    lda     $F2
+    sta     ib_cnt
+    lda     $F3
+    sta     ib_cnt+1
+    lda     ib_page
+    beq     @done
+    sec                     ; hueco = página - (dirección & (página - 1))
+    sbc     #1
+    and     $F6
+    eor     #$FF
+    sec
+    adc     ib_page
+    ldx     $F3             ; longitud > hueco: recortar
+    bne     @clip
+    cmp     $F2
+    bcs     @done
+@clip:
+    sta     ib_cnt
+    lda     #0
+    sta     ib_cnt+1
+@done:
+    rts
+
+; ---------------------------------------------------------------------------
+; wb_bytes - Enviar ib_cnt bytes y STOP. Retorna C = 1 si hubo NACK
+; ---------------------------------------------------------------------------
+wb_bytes:
+    ldy     #0
+    lda     ($F0),y
+    jsr     ROM_I2C_WRITE_BYTE
+    cmp     #0
+    beq     @nack
+    jsr     ib_step
+    lda     ib_cnt
+    bne     :+
+    dec     ib_cnt+1
+:   dec     ib_cnt
+    lda     ib_cnt
+    ora     ib_cnt+1
+    bne     wb_bytes
+    jsr     ROM_I2C_STOP
+    clc
+    rts
+@nack:
+    jsr     ROM_I2C_STOP
+    sec
+    rts
+
+; ---------------------------------------------------------------------------
+; wb_poll - ACK polling: la EEPROM no responde mientras graba la página
+; Retorna C = 1 si no volvió a responder
+; ---------------------------------------------------------------------------
+wb_poll:
+    lda     #ACK_TRIES
+    sta     ib_try
+@loop:
+    lda     #I2C_WRITE
+    jsr     ib_start
+    pha
+    jsr     ROM_I2C_STOP
+    pla
+    bne     @ok
+    dec     ib_try
+    bne     @loop
+    sec
+    rts
+@ok:
+    clc
+    rts
+
+; ---------------------------------------------------------------------------
+; ib_read - Leer hasta vaciar $F2-$F3, con ACK salvo en el último byte
+; ---------------------------------------------------------------------------
+ib_read:
+    lda     $F3
+    bne     @ack
+    lda     $F2
+    cmp     #1
+    bne     @ack
+    lda     #0              ; último: NACK
+    beq     @get
+@ack:
+    lda     #1
+@get:
+    jsr     ROM_I2C_READ_BYTE
+    ldy     #0
+    sta     ($F0),y
+    jsr     ib_step
+    lda     $F2
+    ora     $F3
+    bne     ib_read
+    rts
+
+ib_result:
+    lda     ib_done
+    ldx     ib_done+1
+    rts
+
+; ---------------------------------------------------------------------------
+; i2c_write_buf
+; ---------------------------------------------------------------------------
+i2c_write_buf:
+    sta     ib_page
+    lda     #0
+    sta     ib_done
+    sta     ib_done+1
+wb_chunk:
+    lda     $F2
+    ora     $F3
+    beq     ib_result
+    jsr     wb_len
+    jsr     ib_addr
+    bcs     ib_result
+    jsr     wb_bytes
+    bcs     ib_result
+    lda     ib_page
+    beq     ib_result
+    jsr     wb_poll
+    bcc     wb_chunk
+    bcs     ib_result       ; no vuelve: el siguiente START fallaría
+
+; ---------------------------------------------------------------------------
+; i2c_read_buf
+; ---------------------------------------------------------------------------
+i2c_read_buf:
+    lda     #0
+    sta     ib_done
+    sta     ib_done+1
+    lda     $F2
+    ora     $F3
+    beq     ib_result
+    lda     $F5
+    beq     @start
+    jsr     ib_addr
+    bcs     ib_result
+@start:
+    lda     #I2C_READ       ; START repetido si hubo dirección
+    jsr     ib_start
+    beq     @stop
+    jsr     ib_read
+@stop:
+    jsr     ROM_I2C_STOP
+    jmp     ib_result
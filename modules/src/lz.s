@@ -0,0 +1,189 @@
+;; ===========================================================================
+;; LZ.S - Módulo residente: descompresor LZ65 (scripts/lzpack.py)
+;; ===========================================================================
+;;
+;; Atiende la ranura LZ de la ROM API ($BE36). Formato orientado a bytes,
+;; sin bits sueltos, para descomprimir rápido sin tablas ni buffer aparte
+;; (la ventana es la propia salida):
+;;
+;;   $00         fin
+;;   0LLLLLLL    L bytes literales (1-127) a continuación
+;;   1MMMMMMM    copia de M+3 bytes (3-130) desde la salida anterior:
+;;               0ooooooo          distancia o+1 (1-128)
+;;               1hhhhhhh llllllll distancia (h:l)+1 (1-32768)
+;;
+;; Entrada:
+;;   lz_unpack   $F0-$F1 = origen, $F2-$F3 = destino
+;;               Retorna A/X = bytes escritos
+;;               Origen $0000: lee el archivo MicroFS abierto con $BE00
+;;               (bloques de LZ_BUF_SIZE), sin pasar por RAM del programa
+;;
+;; ptr3 = destino, ptr4 = entrada. $BE00 es C y puede usar los ZP del
+;; runtime: ptr3 se guarda alrededor de la recarga y ptr1 (origen de
+;; la copia) no vive a través de ella.
+;; ===========================================================================
+
+.include "module.inc"
+
+.export mod_setup, mod_desc
+
+.importzp ptr1, ptr3, ptr4
+
+LZ_BUF_SIZE = 64
+
+.segment "RODATA"
+
+mod_desc:
+    .byte X_LZ, 1
+    .word lz_unpack
+
+.segment "BSS"
+lz_buf:   .res LZ_BUF_SIZE      ; bloque leído del archivo
+lz_left:  .res 1                ; bytes sin consumir en lz_buf
+lz_file:  .res 1                ; 0 = memoria, 1 = archivo
+lz_cnt:   .res 1                ; bytes de la secuencia en curso
+lz_ofs:   .res 2                ; distancia - 1
+lz_start: .res 2                ; destino inicial
+
+.segment "CODE"
+
+mod_setup:
+    rts
+
+; ---------------------------------------------------------------------------
+; lz_unpack - origen en $F0-$F1 ($0000 = archivo), destino en $F2-$F3
+; ---------------------------------------------------------------------------
+lz_unpack:
+    ldy     #0
+    sty     lz_left
+    lda     $F0
+    sta     ptr4
+    ora     $F1
+    bne     :+
+    iny                     ; origen 0: archivo abierto
+:   sty     lz_file
+    lda     $F1
+    sta     ptr4+1
+    lda     $F2
+    sta     ptr3
+    sta     lz_start
+    lda     $F3
+    sta     ptr3+1
+    sta     lz_start+1
+
+lz_loop:
+    jsr     lz_in           ; token
+    beq     lz_end
+    bmi     lz_match
+
+; Literales
+    sta     lz_cnt
+@lit:
+    jsr     lz_in
+    ldy     #0
+    sta     (ptr3),y
+    inc     ptr3
+    bne     :+
+    inc     ptr3+1
+:   dec     lz_cnt
+    bne     @lit
+    beq     lz_loop         ; siempre
+
+; Copia desde la salida: ptr1 = ptr3 - distancia
+lz_match:
+    and     #$7F
+    clc
+    adc     #3
+    sta     lz_cnt
+    ldy     #0
+    sty     lz_ofs+1
+    jsr     lz_in
+    bpl     @short
+    and     #$7F
+    sta     lz_ofs+1        ; en RAM: $BE00 no respeta X
+    jsr     lz_in
+@short:
+    sta     lz_ofs
+    lda     ptr3
+    clc                     ; C = 0: resta también el +1
+    sbc     lz_ofs
+    sta     ptr1
+    lda     ptr3+1
+    sbc     lz_ofs+1
+    sta     ptr1+1
+    ldy     #0              ; hacia adelante: admite solape (distancia 1)
+@copy:
+    lda     (ptr1),y
+    sta     (ptr3),y
+    iny
+    cpy     lz_cnt
+    bne     @copy
+    tya
+    clc
+    adc     ptr3
+    sta     ptr3
+    bcc     lz_loop
+    inc     ptr3+1
+    bcs     lz_loop         ; siempre
+
+; A/X = bytes escritos
+lz_end:
+    lda     ptr3
+    sec
+    sbc     lz_start
+    pha
+    lda     ptr3+1
+    sbc     lz_start+1
+    tax
+    pla
+    rts
+
+; ---------------------------------------------------------------------------
+; lz_in - siguiente byte de entrada en A (flags según A). Fin de archivo
+; devuelve 0 (fin de datos)
+; ---------------------------------------------------------------------------
+lz_in:
+    lda     lz_file
+    beq     @mem
+    lda     lz_left
+    bne     @buf
+    jsr     lz_refill
+    beq     @eof
+@buf:
+    dec     lz_left
+@mem:
+    ldy     #0
+    lda     (ptr4),y
+    inc     ptr4
+    bne     :+
+    inc     ptr4+1
+:   tay                     ; flags según el dato
+@eof:
+    rts
+
+; Leer el siguiente bloque del archivo. A = bytes leídos
+lz_refill:
+    lda     ptr3
+    pha
+    lda     ptr3+1
+    pha
+    lda     #<lz_buf
+    sta     $F0
+    lda     #>lz_buf
+    sta     $F1
+    lda     #LZ_BUF_SIZE
+    sta     $F2
+    lda     #0
+    sta     $F3
+    jsr     ROM_MFS_READ3
+    sta     lz_left
+    pla
+    sta     ptr3+1
+    pla
+    sta     ptr3
+    lda     #<lz_buf
+    sta     ptr4
+    lda     #>lz_buf
+    sta     ptr4+1
+    lda     lz_left
+    rts
@@ -0,0 +1,219 @@
+;; ===========================================================================
+;; MEM.S - Módulo residente: copia, relleno y comparación de memoria
+;; ===========================================================================
+;;
+;; Atiende las ranuras MEM de la ROM API ($BE15-$BE1B). Bucles por página
+;; desenrollados x4 (Y recorre la página, X cuenta páginas). Parámetros en
+;; ZP fijo, como el resto del bloque v3:
+;;
+;;   mem_copy    $F0-$F1 = origen, $F2-$F3 = destino, $F4-$F5 = len
+;;               Admite solapamiento (copia hacia atrás si dst > src)
+;;   mem_fill    $F0-$F1 = destino, $F2-$F3 = len, A = valor
+;;   mem_compare $F0-$F1 = a, $F2-$F3 = b, $F4-$F5 = len
+;;               Retorna A/X = 0 (iguales), 1 (a > b) o -1 (a < b)
+;;
+;; ===========================================================================
+
+.include "module.inc"
+
+.export mod_setup, mod_desc
+
+.importzp ptr1, ptr2, tmp1, tmp2
+
+.segment "RODATA"
+
+mod_desc:
+    .byte X_MEM, 3
+    .word mem_copy, mem_fill, mem_compare
+
+.segment "CODE"
+
+mod_setup:
+    rts
+
+; ---------------------------------------------------------------------------
+; mem_copy
+; ---------------------------------------------------------------------------
+mem_copy:
+    lda     $F0
+    sta     ptr1
+    lda     $F1
+    sta     ptr1+1
+    lda     $F2
+    sta     ptr2
+    lda     $F3
+    sta     ptr2+1
+    lda     $F4
+    sta     tmp1            ; bytes sueltos
+    ldx     $F5             ; páginas completas
+
+    ; dst > src: copiar desde el final para no pisar el origen
+    lda     ptr2+1
+    cmp     ptr1+1
+    bne     :+
+    lda     ptr2
+    cmp     ptr1
+:   beq     cp_done         ; mismo bloque
+    bcs     cp_back
+
+; Hacia adelante
+    ldy     #0
+    txa
+    beq     cp_tail
+cp_page:
+    lda     (ptr1),y
+    sta     (ptr2),y
+    iny
+    lda     (ptr1),y
+    sta     (ptr2),y
+    iny
+    lda     (ptr1),y
+    sta     (ptr2),y
+    iny
+    lda     (ptr1),y
+    sta     (ptr2),y
+    iny
+    bne     cp_page
+    inc     ptr1+1
+    inc     ptr2+1
+    dex
+    bne     cp_page
+cp_tail:
+    ldx     tmp1
+    beq     cp_done
+:   lda     (ptr1),y
+    sta     (ptr2),y
+    iny
+    dex
+    bne     :-
+cp_done:
+    rts
+
+; Hacia atrás: primero los bytes sueltos de la última página
+cp_back:
+    stx     tmp2
+    txa
+    clc
+    adc     ptr1+1
+    sta     ptr1+1
+    txa
+    clc
+    adc     ptr2+1
+    sta     ptr2+1
+    ldy     tmp1
+    beq     cp_back_pages
+:   dey
+    lda     (ptr1),y
+    sta     (ptr2),y
+    tya
+    bne     :-
+cp_back_pages:
+    ldx     tmp2
+    beq     cp_done
+cp_back_page:
+    dec     ptr1+1
+    dec     ptr2+1
+    ldy     #0
+:   dey
+    lda     (ptr1),y
+    sta     (ptr2),y
+    dey
+    lda     (ptr1),y
+    sta     (ptr2),y
+    dey
+    lda     (ptr1),y
+    sta     (ptr2),y
+    dey
+    lda     (ptr1),y
+    sta     (ptr2),y
+    tya
+    bne     :-
+    dex
+    bne     cp_back_page
+    rts
+
+; ---------------------------------------------------------------------------
+; mem_fill
+; ---------------------------------------------------------------------------
+mem_fill:
+    ldx     $F0
+    stx     ptr2
+    ldx     $F1
+    stx     ptr2+1
+    ldy     #0
+    ldx     $F3             ; páginas completas
+    beq     fl_tail
+fl_page:
+    sta     (ptr2),y
+    iny
+    sta     (ptr2),y
+    iny
+    sta     (ptr2),y
+    iny
+    sta     (ptr2),y
+    iny
+    bne     fl_page
+    inc     ptr2+1
+    dex
+    bne     fl_page
+fl_tail:
+    ldx     $F2
+    beq     fl_done
+:   sta     (ptr2),y
+    iny
+    dex
+    bne     :-
+fl_done:
+    rts
+
+; ---------------------------------------------------------------------------
+; mem_compare
+; ---------------------------------------------------------------------------
+.macro CMP_STEP
+    lda     (ptr1),y
+    cmp     (ptr2),y
+    bne     mc_diff
+    iny
+.endmacro
+
+mem_compare:
+    lda     $F0
+    sta     ptr1
+    lda     $F1
+    sta     ptr1+1
+    lda     $F2
+    sta     ptr2
+    lda     $F3
+    sta     ptr2+1
+    ldy     #0
+    ldx     $F5
+    beq     mc_tail
+mc_page:
+    CMP_STEP
+    CMP_STEP
+    CMP_STEP
+    CMP_STEP
+    bne     mc_page
+    inc     ptr1+1
+    inc     ptr2+1
+    dex
+    bne     mc_page
+mc_tail:
+    ldx     $F4
+    beq     mc_equal
+:   CMP_STEP
+    dex
+    bne     :-
+mc_equal:
+    lda     #0
+    tax
+    rts
+mc_diff:
+    bcc     mc_less
+    lda     #1
+    ldx     #0
+    rts
+mc_less:
+    lda     #$FF
+    tax
+    rts
@@ -0,0 +1,36 @@
+; ============================================
+; mod_init.s - Entrada común de los módulos residentes
+; ============================================
+; Es el punto de entrada de la imagen X65 (R tras el LOAD):
+;   1. jsr mod_setup: lo que el módulo prepare antes de atender
+;      (RTS si no necesita nada)
+;   2. registra mod_desc con ext_register ($BE69)
+; y vuelve al monitor con el código ya residente. Cada módulo exporta
+; mod_setup y mod_desc: { first, count, vec[count] }
+; ============================================
+
+.include "module.inc"
+
+.import mod_setup, mod_desc
+
+.segment "STARTUP"
+
+mod_init:
+    jsr mod_setup
+    lda #<mod_desc
+    sta $F0
+    lda #>mod_desc
+    sta $F1
+    jsr ROM_EXT_REGISTER
+    cmp #0
+    bne @err
+    rts
+@err:
+    lda #<msg_err
+    ldx #>msg_err
+    jmp ROM_UART_PUTS
+
+.segment "RODATA"
+
+msg_err:
+    .byte "Ranuras no validas", $0D, $0A, 0
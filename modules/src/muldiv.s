@@ -0,0 +1,131 @@
+;; ===========================================================================
+;; MULDIV.S - Módulo residente: multiplicación y división enteras
+;; ===========================================================================
+;;
+;; Atiende las ranuras MULDIV de la ROM API ($BE1E-$BE24). No caben en la
+;; ROM; el formato de números (BCD, u16toa, u32toa) sí sigue en ella
+;; (src/fastmath.s).
+;;
+;; Entradas (ZP fijo, por la dirección de la ROM):
+;;   $BE1E mul8x8    A * X -> A/X
+;;   $BE21 mul16x16  $F0-$F1 * $F2-$F3 -> $F4-$F7 (A/X = 16 bits bajos)
+;;   $BE24 div32x16  $F0-$F3 / $F4-$F5 -> cociente en $F0-$F3,
+;;                   resto en $F4-$F5 y A/X. Divisor 0: cociente $FFFFFFFF
+;;
+;; Usa tmp1/tmp2 del runtime (libres entre llamadas, como en CC65).
+;; ===========================================================================
+
+.include "module.inc"
+
+.export mod_setup, mod_desc
+
+.importzp tmp1, tmp2
+
+.segment "RODATA"
+
+mod_desc:
+    .byte X_MULDIV, 3
+    .word mul8x8, mul16x16, div32x16
+
+.segment "CODE"
+
+mod_setup:
+    rts
+
+; ---------------------------------------------------------------------------
+; mul8x8 - A * X -> A (bajo) / X (alto)
+; ---------------------------------------------------------------------------
+mul8x8:
+    sta     tmp1            ; multiplicando
+    stx     tmp2            ; multiplicador / byte bajo del producto
+    lda     #0
+    ldx     #8
+    lsr     tmp2
+@loop:
+    bcc     :+
+    clc
+    adc     tmp1
+:   ror     a
+    ror     tmp2
+    dex
+    bne     @loop
+    tax
+    lda     tmp2
+    rts
+
+; ---------------------------------------------------------------------------
+; mul16x16 - $F0-$F1 * $F2-$F3 -> $F4-$F7
+; ---------------------------------------------------------------------------
+mul16x16:
+    lda     $F0
+    sta     tmp1
+    lda     $F1
+    sta     tmp2
+    lda     #0
+    sta     $F6
+    sta     $F7
+    ldx     #16
+@loop:
+    lsr     tmp2
+    ror     tmp1            ; C = bit del multiplicador
+    bcc     :+
+    lda     $F6
+    clc
+    adc     $F2
+    sta     $F6
+    lda     $F7
+    adc     $F3
+    sta     $F7             ; C = acarreo al bit 32
+:   ror     $F7
+    ror     $F6
+    ror     $F5
+    ror     $F4
+    dex
+    bne     @loop
+    lda     $F4
+    ldx     $F5
+    rts
+
+; ---------------------------------------------------------------------------
+; div32x16 - $F0-$F3 / $F4-$F5 (restas sucesivas, 32 iteraciones)
+; El resto usa 17 bits: si el bit 16 sale a C la resta es obligada
+; ---------------------------------------------------------------------------
+div32x16:
+    lda     #0
+    sta     tmp1
+    sta     tmp2
+    ldx     #32
+@loop:
+    asl     $F0
+    rol     $F1
+    rol     $F2
+    rol     $F3
+    rol     tmp1
+    rol     tmp2
+    bcs     @big
+    lda     tmp1
+    sec
+    sbc     $F4
+    tay
+    lda     tmp2
+    sbc     $F5
+    bcc     @next
+    bcs     @store
+@big:
+    lda     tmp1            ; C = 1: resta sin SEC
+    sbc     $F4
+    tay
+    lda     tmp2
+    sbc     $F5
+@store:
+    sta     tmp2
+    sty     tmp1
+    inc     $F0             ; bit del cociente
+@next:
+    dex
+    bne     @loop
+    lda     tmp1
+    sta     $F4
+    ldx     tmp2
+    stx     $F5
+    rts
@@ -0,0 +1,638 @@
+;; ===========================================================================
+;; SCHED.S - Módulo residente: tareas en segundo plano y alarmas
+;; ===========================================================================
+;;
+;; Atiende las ranuras TASK y ALARM de la ROM API ($BE4E-$BE5A, ranuras
+;; consecutivas: un solo descriptor). Tabla fija de
+;; SCHED_MAX tareas periódicas. El monitor llama a task_yield mientras
+;; espera teclas (mon_read_line) y un programa en primer plano lo hace
+;; en su bucle. Cada tarea es una función corta que retorna: corre sobre
+;; el stack de quien cede, y su ZP propia se intercambia con zp_save
+;; alrededor de la llamada para no pisar la del programa en primer plano.
+;;
+;; Descriptor (rom_task_t, en la RAM del programa mientras esté
+;; registrada):
+;;   +0 fn        uint8_t fn(void): SCHED_KEEP o SCHED_DONE (quitarla)
+;;   +2 period    ticks de 1024 us entre ejecuciones, 0 = en cada yield
+;;   +4 zp        primera dirección de ZP propia ($28-$7F)
+;;   +5 zp_len    0 = sin ZP propia
+;;   +6 zp_save   zp_len bytes: la ZP de la tarea entre llamadas
+;;   +8 due       lo rellena el módulo
+;;   +10 tag      SCHED_TAG
+;;
+;; Entradas (por la dirección de la ROM):
+;;   task_add     $F0-$F1 = descriptor. Retorna A = slot (o el que ya
+;;                tenía), $FF si la tabla está llena o el nodo no vale
+;;   task_remove  $F0-$F1 = descriptor (0 = todas)
+;;   task_yield   ejecuta las tareas vencidas. Dentro de una tarea no
+;;                hace nada (sin anidamiento)
+;;
+;; Alarma (rom_alarm_t, en la RAM del programa): lista ordenada por
+;; vencimiento (la cabeza es la próxima); alarm_set inserta en orden y
+;; task_yield, antes de las tareas, solo mira la cabeza:
+;;   +0 next      lo rellena el módulo
+;;   +2 due       get_micros del vencimiento, lo rellena el módulo
+;;   +6 period    us, 0 = un disparo
+;;   +10 fn       void fn(rom_alarm_t *a), a en A/X
+;;   +12 tag      ALARM_TAG
+;;
+;;   alarm_set    $F0-$F1 = alarma, $F2-$F5 = retraso en us (< 2^31).
+;;                Si ya estaba en la lista se mueve. Retorna A = 0, $FF
+;;                si el nodo no lleva ALARM_TAG o no tiene fn
+;;   alarm_cancel $F0-$F1 = alarma (0 = todas)
+;;
+;; Las periódicas se reprograman desde su vencimiento (sin deriva) antes
+;; de llamar a fn; si ya van atrasadas un periodo entero, desde ahora
+;; (sin ráfagas). Solo se despachan las vencidas al entrar.
+;;
+;; Sin IRQ: el tiempo es get_micros ($BF2D), leído en cada yield; el
+;; tick de las tareas es get_micros >> 10.
+;; ===========================================================================
+
+.include "module.inc"
+
+.export mod_setup, mod_desc
+
+.importzp ptr1, ptr2, ptr3, sreg
+
+SCHED_MAX   = 4
+SCHED_TAG   = $7A
+SCHED_DONE  = 1
+SCHED_FULL  = $FF
+
+; Campos del descriptor
+T_FN        = 0
+T_PERIOD    = 2
+T_ZP        = 4
+T_ZP_LEN    = 5
+T_ZP_SAVE   = 6
+T_DUE       = 8
+T_TAG       = 10
+
+ALARM_TAG   = $A1
+
+; Campos de la alarma
+A_NEXT      = 0
+A_DUE       = 2
+A_PERIOD    = 6
+A_FN        = 10
+A_TAG       = 12
+
+.segment "RODATA"
+
+mod_desc:
+    .byte X_TASK, 5             ; X_ALARM = X_TASK + 3
+    .word task_add, task_remove, task_yield
+    .word alarm_set, alarm_cancel
+
+.segment "BSS"
+sc_tab:     .res SCHED_MAX * 2  ; descriptores, 0 = libre
+sc_busy:    .res 1              ; dentro de task_yield
+sc_i:       .res 1              ; slot en curso (x2)
+sc_t:       .res 2              ; descriptor en curso
+sc_now:     .res 2              ; tick de este yield
+sc_fn:      .res 2              ; rutina de la tarea en curso
+sc_zp:      .res 1
+sc_len:     .res 1
+al_head:    .res 2              ; primera alarma (enlace como el de un nodo)
+al_now:     .res 4              ; get_micros
+al_pnow:    .res 4              ; get_micros al entrar en al_poll
+al_da:      .res 4              ; due - now del nodo a insertar
+al_dn:      .res 4              ; due - now del nodo comparado
+al_per:     .res 4
+al_fn:      .res 2
+
+.segment "CODE"
+
+; Tabla y lista vacías
+mod_setup:
+    lda     #0
+    sta     sc_busy
+    sta     al_head
+    sta     al_head+1
+    ldx     #SCHED_MAX * 2 - 1
+:   sta     sc_tab,x
+    dex
+    bpl     :-
+    rts
+
+; ---------------------------------------------------------------------------
+; sc_tick - sc_now = get_micros >> 10 (16 bits bajos)
+; ---------------------------------------------------------------------------
+sc_tick:
+    jsr     ROM_GET_MICROS
+    stx     sc_now
+    lda     sreg
+    sta     sc_now+1
+    lda     sreg+1
+    lsr     a
+    ror     sc_now+1
+    ror     sc_now
+    lsr     a
+    ror     sc_now+1
+    ror     sc_now
+    rts
+
+; ---------------------------------------------------------------------------
+; task_add - $F0-$F1 = descriptor
+; ---------------------------------------------------------------------------
+task_add:
+    lda     $F0
+    ora     $F1
+    beq     @full
+    ldy     #T_TAG
+    lda     ($F0),y
+    cmp     #SCHED_TAG
+    bne     @full
+    ldy     #T_FN
+    lda     ($F0),y
+    iny
+    ora     ($F0),y
+    beq     @full
+    ldy     #SCHED_FULL     ; Y = primer slot libre (x2)
+    ldx     #0
+@scan:
+    lda     sc_tab,x
+    cmp     $F0
+    bne     :+
+    lda     sc_tab+1,x
+    cmp     $F1
+    beq     @slot           ; ya registrada
+:   lda     sc_tab,x
+    ora     sc_tab+1,x
+    bne     :+
+    cpy     #SCHED_FULL
+    bne     :+
+    txa
+    tay
+:   inx
+    inx
+    cpx     #SCHED_MAX * 2
+    bne     @scan
+    cpy     #SCHED_FULL
+    beq     @full
+    tya
+    pha
+    jsr     sc_tick         ; vence en el siguiente yield
+    ldy     #T_DUE
+    lda     sc_now
+    sta     ($F0),y
+    iny
+    lda     sc_now+1
+    sta     ($F0),y
+    pla
+    tax
+    lda     $F0
+    sta     sc_tab,x
+    lda     $F1
+    sta     sc_tab+1,x
+@slot:
+    txa
+    lsr     a
+    ldx     #0
+    rts
+@full:
+    lda     #SCHED_FULL
+    ldx     #0
+    rts
+
+; ---------------------------------------------------------------------------
+; task_remove - $F0-$F1 = descriptor (0 = todas)
+; ---------------------------------------------------------------------------
+task_remove:
+    ldx     #SCHED_MAX * 2 - 2
+@loop:
+    lda     $F0
+    ora     $F1
+    beq     @free
+    lda     sc_tab,x
+    cmp     $F0
+    bne     @next
+    lda     sc_tab+1,x
+    cmp     $F1
+    bne     @next
+@free:
+    lda     #0
+    sta     sc_tab,x
+    sta     sc_tab+1,x
+@next:
+    dex
+    dex
+    bpl     @loop
+    rts
+
+; ---------------------------------------------------------------------------
+; task_yield - ejecutar las tareas vencidas
+; ---------------------------------------------------------------------------
+task_yield:
+    lda     sc_busy
+    bne     @ret
+    inc     sc_busy
+    jsr     al_poll
+    jsr     sc_tick
+    lda     #0
+    sta     sc_i
+@loop:
+    jsr     sc_load         ; ptr1 = descriptor, Z si libre
+    beq     @next
+    ldy     #T_TAG          ; descriptor pisado: no saltar a basura
+    lda     (ptr1),y
+    cmp     #SCHED_TAG
+    bne     @drop
+    ldy     #T_DUE          ; (int16)(now - due) < 0: no vence
+    lda     sc_now
+    sec
+    sbc     (ptr1),y
+    iny
+    lda     sc_now+1
+    sbc     (ptr1),y
+    bmi     @next
+    ; Desde ahora, no desde el vencimiento: un yield tardío no encadena
+    ; ejecuciones atrasadas
+    ldy     #T_PERIOD
+    lda     sc_now
+    clc
+    adc     (ptr1),y
+    ldy     #T_DUE
+    sta     (ptr1),y
+    ldy     #T_PERIOD+1
+    lda     sc_now+1
+    adc     (ptr1),y
+    ldy     #T_DUE+1
+    sta     (ptr1),y
+    ldy     #T_FN
+    lda     (ptr1),y
+    sta     sc_fn
+    iny
+    lda     (ptr1),y
+    sta     sc_fn+1
+    lda     ptr1
+    sta     sc_t
+    lda     ptr1+1
+    sta     sc_t+1
+    jsr     sc_swap_zp
+    jsr     sc_call
+    pha
+    lda     sc_t            ; la tarea puede haber usado ptr1
+    sta     ptr1
+    lda     sc_t+1
+    sta     ptr1+1
+    jsr     sc_swap_zp
+    pla
+    cmp     #SCHED_DONE
+    bne     @next
+    jsr     sc_load         ; quitarla si sigue en su slot
+    lda     ptr1
+    cmp     sc_t
+    bne     @next
+    lda     ptr1+1
+    cmp     sc_t+1
+    bne     @next
+@drop:
+    ldx     sc_i
+    lda     #0
+    sta     sc_tab,x
+    sta     sc_tab+1,x
+@next:
+    lda     sc_i
+    clc
+    adc     #2
+    sta     sc_i
+    cmp     #SCHED_MAX * 2
+    bne     @loop
+    lda     #0
+    sta     sc_busy
+@ret:
+    rts
+
+; A = retorno de la tarea
+sc_call:
+    jmp     (sc_fn)
+
+; ptr1 = sc_tab[sc_i]; Z = 1 si el slot está libre
+sc_load:
+    ldx     sc_i
+    lda     sc_tab,x
+    sta     ptr1
+    lda     sc_tab+1,x
+    sta     ptr1+1
+    ora     ptr1
+    rts
+
+; ---------------------------------------------------------------------------
+; sc_swap_zp - Intercambiar la ZP de la tarea (ptr1) con zp_save: el
+; mismo intercambio entra y sale, sin buffer en el módulo
+; ---------------------------------------------------------------------------
+sc_swap_zp:
+    ldy     #T_ZP
+    lda     (ptr1),y
+    sta     sc_zp
+    iny
+    lda     (ptr1),y
+    beq     @done
+    sta     sc_len
+    iny
+    lda     (ptr1),y
+    sta     ptr2
+    iny
+    lda     (ptr1),y
+    sta     ptr2+1
+    ldx     sc_zp
+    ldy     #0
+@loop:
+    lda     $00,x
+    pha
+    lda     (ptr2),y
+    sta     $00,x
+    pla
+    sta     (ptr2),y
+    inx
+    iny
+    cpy     sc_len
+    bne     @loop
+@done:
+    rts
+
+; ---------------------------------------------------------------------------
+; al_tick - al_now = get_micros
+; ---------------------------------------------------------------------------
+al_tick:
+    jsr     ROM_GET_MICROS
+    sta     al_now
+    stx     al_now+1
+    lda     sreg
+    sta     al_now+2
+    lda     sreg+1
+    sta     al_now+3
+    rts
+
+; ---------------------------------------------------------------------------
+; alarm_set - $F0-$F1 = alarma, $F2-$F5 = retraso
+; ---------------------------------------------------------------------------
+alarm_set:
+    lda     $F0
+    ora     $F1
+    beq     @fail
+    ldy     #A_TAG
+    lda     ($F0),y
+    cmp     #ALARM_TAG
+    bne     @fail
+    ldy     #A_FN
+    lda     ($F0),y
+    iny
+    ora     ($F0),y
+    beq     @fail
+    lda     $F0
+    sta     ptr1
+    lda     $F1
+    sta     ptr1+1
+    jsr     al_unlink
+    jsr     al_tick
+    ldy     #A_DUE          ; due = now + retraso
+    ldx     #0
+    clc
+:   lda     al_now,x
+    adc     $F2,x
+    sta     (ptr1),y
+    iny
+    inx
+    txa                     ; sin tocar C
+    eor     #4
+    bne     :-
+    jsr     al_insert
+    lda     #0
+    tax
+    rts
+@fail:
+    lda     #$FF
+    ldx     #0
+    rts
+
+; ---------------------------------------------------------------------------
+; alarm_cancel - $F0-$F1 = alarma (0 = todas)
+; ---------------------------------------------------------------------------
+alarm_cancel:
+    lda     $F0
+    sta     ptr1
+    lda     $F1
+    sta     ptr1+1
+    ora     ptr1
+    bne     al_unlink
+    sta     al_head
+    sta     al_head+1
+    rts
+
+; ---------------------------------------------------------------------------
+; al_unlink - Quitar ptr1 de la lista si está. ptr2 = enlace (&next),
+; ptr3 = nodo al que apunta
+; ---------------------------------------------------------------------------
+al_unlink:
+    lda     #<al_head
+    sta     ptr2
+    lda     #>al_head
+    sta     ptr2+1
+@loop:
+    jsr     al_follow
+    beq     @done
+    lda     ptr3
+    cmp     ptr1
+    bne     @adv
+    lda     ptr3+1
+    cmp     ptr1+1
+    bne     @adv
+    ldy     #A_NEXT         ; *pp = a->next
+    lda     (ptr1),y
+    sta     (ptr2),y
+    iny
+    lda     (ptr1),y
+    sta     (ptr2),y
+@done:
+    rts
+@adv:
+    jsr     al_advance
+    jmp     @loop
+
+; ptr3 = *ptr2; Z = 1 si es el final
+al_follow:
+    ldy     #A_NEXT
+    lda     (ptr2),y
+    sta     ptr3
+    iny
+    lda     (ptr2),y
+    sta     ptr3+1
+    ora     ptr3
+    rts
+
+; ptr2 = &ptr3->next (next es el primer campo)
+al_advance:
+    lda     ptr3
+    sta     ptr2
+    lda     ptr3+1
+    sta     ptr2+1
+    rts
+
+; ---------------------------------------------------------------------------
+; al_insert - Insertar ptr1 en orden de vencimiento respecto a al_now; a
+; igualdad, detrás de las que ya estaban (orden de programación)
+; ---------------------------------------------------------------------------
+al_insert:
+    ldy     #A_DUE          ; al_da = a->due - now
+    ldx     #0
+    sec
+:   lda     (ptr1),y
+    sbc     al_now,x
+    sta     al_da,x
+    iny
+    inx
+    txa
+    eor     #4
+    bne     :-
+    lda     #<al_head
+    sta     ptr2
+    lda     #>al_head
+    sta     ptr2+1
+@loop:
+    jsr     al_follow
+    beq     @link
+    ldy     #A_DUE          ; al_dn = n->due - now
+    ldx     #0
+    sec
+:   lda     (ptr3),y
+    sbc     al_now,x
+    sta     al_dn,x
+    iny
+    inx
+    txa
+    eor     #4
+    bne     :-
+    lda     al_da           ; da < dn (con signo): va delante de n
+    cmp     al_dn
+    lda     al_da+1
+    sbc     al_dn+1
+    lda     al_da+2
+    sbc     al_dn+2
+    lda     al_da+3
+    sbc     al_dn+3
+    bvc     :+
+    eor     #$80
+:   bmi     @link
+    jsr     al_advance
+    jmp     @loop
+@link:
+    ldy     #A_NEXT         ; a->next = n; *pp = a
+    lda     ptr3
+    sta     (ptr1),y
+    lda     ptr1
+    sta     (ptr2),y
+    iny
+    lda     ptr3+1
+    sta     (ptr1),y
+    lda     ptr1+1
+    sta     (ptr2),y
+    rts
+
+; ---------------------------------------------------------------------------
+; al_poll - Despachar las alarmas vencidas (desde task_yield)
+; ---------------------------------------------------------------------------
+al_poll:
+    jsr     al_tick
+    ldx     #3
+:   lda     al_now,x
+    sta     al_pnow,x
+    dex
+    bpl     :-
+@loop:
+    lda     al_head
+    sta     ptr1
+    lda     al_head+1
+    sta     ptr1+1
+    ora     ptr1
+    beq     @ret
+    ldy     #A_TAG          ; nodo pisado (programa sobrescrito):
+    lda     (ptr1),y        ; vaciar la lista
+    cmp     #ALARM_TAG
+    beq     :+
+    lda     #0
+    sta     al_head
+    sta     al_head+1
+@ret:
+    rts
+:   jsr     al_late         ; (int32)(now - due) < 0: aún no
+    bmi     @ret
+    ldy     #A_NEXT         ; sacarla de la cabeza
+    lda     (ptr1),y
+    sta     al_head
+    iny
+    lda     (ptr1),y
+    sta     al_head+1
+    ldy     #A_PERIOD       ; al_per = period; 0 = un disparo
+    ldx     #0
+:   lda     (ptr1),y
+    sta     al_per,x
+    iny
+    inx
+    cpx     #4
+    bne     :-
+    lda     al_per
+    ora     al_per+1
+    ora     al_per+2
+    ora     al_per+3
+    beq     @call
+    ldy     #A_DUE          ; due += period
+    ldx     #0
+    clc
+:   lda     (ptr1),y
+    adc     al_per,x
+    sta     (ptr1),y
+    iny
+    inx
+    txa
+    eor     #4
+    bne     :-
+    jsr     al_late         ; muy atrasada: desde ahora, sin ráfagas
+    bmi     @ins
+    ldy     #A_DUE
+    ldx     #0
+    clc
+:   lda     al_pnow,x
+    adc     al_per,x
+    sta     (ptr1),y
+    iny
+    inx
+    txa
+    eor     #4
+    bne     :-
+@ins:
+    jsr     al_insert
+@call:
+    ldy     #A_FN
+    lda     (ptr1),y
+    sta     al_fn
+    iny
+    lda     (ptr1),y
+    sta     al_fn+1
+    lda     ptr1
+    ldx     ptr1+1
+    jsr     al_call
+    jmp     @loop
+
+; fn(a), a en A/X
+al_call:
+    jmp     (al_fn)
+
+; N = signo de (al_pnow - ptr1->due)
+al_late:
+    ldy     #A_DUE
+    lda     al_pnow
+    sec
+    sbc     (ptr1),y
+    iny
+    lda     al_pnow+1
+    sbc     (ptr1),y
+    iny
+    lda     al_pnow+2
+    sbc     (ptr1),y
+    iny
+    lda     al_pnow+3
+    sbc     (ptr1),y
+    rts
@@ -0,0 +1,291 @@
+;; ===========================================================================
+;; SPIBLK.S - Módulo residente: transferencia SPI en bloque
+;; ===========================================================================
+;;
+;; Atiende las ranuras SPIBLK y BUSBLK de la ROM API: spi_transfer_block
+;; ($BF9C y $BE12) y spi_xfer_buf ($BE5D). Sustituye el bucle de
+;; spi_transfer() por byte por un bucle desenrollado x4 que solapa la
+;; espera de TRDY/RRDY con el guardado en el buffer: el byte k+1 se
+;; escribe en TX (y empieza a desplazarse) antes de leer y guardar el
+;; byte k. Las ranuras de I2C en bloque son del módulo I2CBLK.
+;;
+;; Registros SPI ($C040-$C045):
+;;   $C040 RX Data   (lectura)
+;;   $C041 TX Data   (escritura inicia TX)
+;;   $C042 Status    bit7 = RRDY, bit6 = TRDY (se prueban con BIT: N, V)
+;;
+;; spi_transfer_block:
+;;   $F0-$F1 = buffer, $F2-$F3 = longitud (0 = nada)
+;;   A = SPI_BLK_READ ($FF): envía $FF y guarda lo recibido en buffer
+;;   A = SPI_BLK_WRITE ($00): envía el buffer y descarta lo recibido
+;;
+;; spi_xfer_buf, full duplex con dos buffers:
+;;   $F0-$F1 = TX (0 = enviar $FF), $F2-$F3 = RX (0 = descartar),
+;;   $F4-$F5 = longitud (0 = nada). TX y RX pueden ser el mismo buffer
+;;
+;; El controlador no tiene registro de divisor de reloj, así que no hay
+;; cambio a reloj rápido tras sd_init. Los sectores de la ROM ($BF72/
+;; $BF75) siguen por la librería SD: el núcleo no cabe en la ROM.
+;; ===========================================================================
+
+.include "module.inc"
+
+.export mod_setup, mod_desc
+
+.importzp ptr1, ptr2, tmp1, tmp2, tmp3
+
+SPI_RX      = $C040
+SPI_TX      = $C041
+SPI_STATUS  = $C042
+
+.segment "RODATA"
+
+mod_desc:
+    .byte X_SPIBLK, 2
+    .word spi_transfer_block, spi_xfer_buf
+
+.segment "CODE"
+
+mod_setup:
+    rts
+
+; ---------------------------------------------------------------------------
+; spi_transfer_block - Entrada de la ranura
+; Input: A = modo, $F0-$F1 = buffer, $F2-$F3 = longitud
+; ---------------------------------------------------------------------------
+spi_transfer_block:
+    ldx     $F0
+    stx     ptr1
+    ldx     $F1
+    stx     ptr1+1
+    ldx     $F2
+    stx     tmp1
+    ldx     $F3
+    stx     tmp2
+    ; continúa en spi_block_xfer
+
+; ---------------------------------------------------------------------------
+; spi_block_xfer - Núcleo
+; Input: A = modo, ptr1 = buffer, tmp1/tmp2 = longitud (lo/hi)
+; Longitud 0 retorna sin transferir (no da la vuelta a 64 KB)
+; Usa: A, X, Y, ptr1, ptr2, tmp1, tmp2, tmp3
+; ---------------------------------------------------------------------------
+spi_block_xfer:
+    sta     tmp3
+    lda     tmp1
+    ora     tmp2
+    bne     :+
+    rts
+    ; Bucle principal = longitud - 1 (el último byte no encola siguiente)
+:   lda     tmp1
+    bne     :+
+    dec     tmp2
+:   dec     tmp1
+    ldy     #0
+    ldx     tmp2            ; X = páginas completas
+    bit     tmp3
+    bmi     rd_start
+
+; ---------------------------------------------------------------------------
+; Modo escritura: ptr2 = buffer+1 apunta al siguiente byte a enviar
+; ---------------------------------------------------------------------------
+    clc
+    lda     ptr1
+    adc     #1
+    sta     ptr2
+    lda     ptr1+1
+    adc     #0
+    sta     ptr2+1
+    lda     (ptr1),y
+    sta     SPI_TX          ; byte 0
+    txa
+    beq     wr_tail
+
+.macro WR_STEP
+    .local  t, r
+t:  bit     SPI_STATUS
+    bvc     t               ; TRDY: encolar byte k+1
+    lda     (ptr2),y
+    sta     SPI_TX
+r:  bit     SPI_STATUS
+    bpl     r               ; RRDY: byte k terminado
+    lda     SPI_RX          ; descartar
+    iny
+.endmacro
+
+wr_page:
+    WR_STEP
+    WR_STEP
+    WR_STEP
+    WR_STEP
+    bne     wr_page
+    inc     ptr2+1
+    dex
+    bne     wr_page
+
+wr_tail:
+    ldx     tmp1
+    beq     wr_last
+wr_tail_loop:
+    WR_STEP
+    bne     :+
+    inc     ptr2+1
+:   dex
+    bne     wr_tail_loop
+
+wr_last:
+:   bit     SPI_STATUS
+    bpl     :-
+    lda     SPI_RX
+    rts
+
+; ---------------------------------------------------------------------------
+; Modo lectura: envía $FF, guarda en (ptr1),y
+; ---------------------------------------------------------------------------
+rd_start:
+    lda     #$FF
+    sta     SPI_TX          ; byte 0
+    txa
+    beq     rd_tail
+
+.macro RD_STEP
+    .local  t, r
+t:  bit     SPI_STATUS
+    bvc     t               ; TRDY: encolar byte k+1
+    lda     #$FF
+    sta     SPI_TX
+r:  bit     SPI_STATUS
+    bpl     r               ; RRDY: byte k listo
+    lda     SPI_RX
+    sta     (ptr1),y
+    iny
+.endmacro
+
+rd_page:
+    RD_STEP
+    RD_STEP
+    RD_STEP
+    RD_STEP
+    bne     rd_page
+    inc     ptr1+1
+    dex
+    bne     rd_page
+
+rd_tail:
+    ldx     tmp1
+    beq     rd_last
+rd_tail_loop:
+    RD_STEP
+    bne     :+
+    inc     ptr1+1
+:   dex
+    bne     rd_tail_loop
+
+rd_last:
+:   bit     SPI_STATUS
+    bpl     :-
+    lda     SPI_RX
+    sta     (ptr1),y
+    rts
+
+; ---------------------------------------------------------------------------
+; spi_xfer_buf - Entrada de la ranura BUSBLK (full duplex)
+; Input: $F0-$F1 = TX, $F2-$F3 = RX, $F4-$F5 = longitud
+; Con un solo buffer usa los modos de spi_block_xfer
+; ---------------------------------------------------------------------------
+spi_xfer_buf:
+    lda     $F4
+    sta     tmp1
+    ora     $F5
+    beq     fd_none
+    lda     $F5
+    sta     tmp2
+    lda     $F0
+    ora     $F1
+    bne     fd_tx
+    lda     $F2             ; solo RX: modo lectura
+    sta     ptr1
+    lda     $F3
+    sta     ptr1+1
+    ora     ptr1
+    beq     fd_none
+    lda     #$FF
+    jmp     spi_block_xfer
+fd_tx:
+    lda     $F0
+    sta     ptr1
+    lda     $F1
+    sta     ptr1+1
+    lda     $F2
+    ora     $F3
+    bne     fd_start
+    jmp     spi_block_xfer  ; solo TX: modo escritura (A = 0)
+fd_none:
+    rts
+
+; ---------------------------------------------------------------------------
+; Full duplex: ptr2 = TX+1 (siguiente a enviar), ptr1 = RX
+; ---------------------------------------------------------------------------
+fd_start:
+    clc
+    lda     ptr1
+    adc     #1
+    sta     ptr2
+    lda     ptr1+1
+    adc     #0
+    sta     ptr2+1
+    lda     $F2
+    sta     ptr1
+    lda     $F3
+    sta     ptr1+1
+    lda     tmp1            ; bucle principal = longitud - 1
+    bne     :+
+    dec     tmp2
+:   dec     tmp1
+    ldy     #0
+    lda     ($F0),y
+    sta     SPI_TX          ; byte 0
+    ldx     tmp2            ; X = páginas completas
+    beq     fd_tail
+
+.macro FD_STEP
+    .local  t, r
+t:  bit     SPI_STATUS
+    bvc     t               ; TRDY: encolar byte k+1
+    lda     (ptr2),y
+    sta     SPI_TX
+r:  bit     SPI_STATUS
+    bpl     r               ; RRDY: byte k listo
+    lda     SPI_RX
+    sta     (ptr1),y
+    iny
+.endmacro
+
+fd_page:
+    FD_STEP
+    FD_STEP
+    FD_STEP
+    FD_STEP
+    bne     fd_page
+    inc     ptr1+1
+    inc     ptr2+1
+    dex
+    bne     fd_page
+
+fd_tail:
+    ldx     tmp1
+    beq     fd_last
+fd_tail_loop:
+    FD_STEP
+    bne     :+
+    inc     ptr1+1
+    inc     ptr2+1
+:   dex
+    bne     fd_tail_loop
+
+fd_last:
+:   bit     SPI_STATUS
+    bpl     :-
+    lda     SPI_RX
+    sta     (ptr1),y
+    rts
@@ -0,0 +1,298 @@
+;; ===========================================================================
+;; STREAM.S - Módulo residente: lectura de archivos en streaming
+;; ===========================================================================
+;;
+;; Atiende las ranuras STREAM de la ROM API ($BF9F-$BFA8, $BF96/$BF99 y
+;; $BE09). Anillo de 2 sectores (1024 bytes) en RAM del programa: el
+;; consumidor lee bytes de RAM y la mitad ya consumida se recarga en
+;; poll, llamado desde el tick del programa, o al cruzar la mitad (modo
+;; auto). Lee por $BE00/$BE06 de la ROM, así que sirve la MicroFS que
+;; tenga la ROM.
+;;
+;; Entradas (por la dirección de la ROM):
+;;   open   $F4-$F5 = nombre, $F6-$F7 = anillo (1024 bytes)
+;;          A = flags ($00 recarga con poll, $01 recarga al cruzar la
+;;          mitad). Retorna A = MFS_OK o error de MicroFS
+;;   getc   A = byte (X = 0), o A/X = $FFFF al final del archivo
+;;   poll   recarga la mitad consumida, si hay una pendiente. No desde
+;;          una IRQ: pasa por MicroFS y el stack de CC65 del monitor
+;;   close
+;;   seek   $F0-$F3 = posición. MicroFS solo lee en secuencia: avanza
+;;          leyendo y, hacia atrás, reabre el archivo. A = 0, o $FF si
+;;          el archivo es más corto (queda al final)
+;;   tell   A/X/sreg = bytes leídos con getc desde el principio
+;; ===========================================================================
+
+.include "module.inc"
+
+.export mod_setup, mod_desc
+
+.importzp ptr1, tmp1, tmp2, sreg
+
+HALF_SIZE       = 512
+NO_PENDING      = $FF
+MFS_STREAM_AUTO = $01
+
+.segment "RODATA"
+
+mod_desc:
+    .byte X_STREAM, 6
+    .word st_open, st_getc, st_poll, st_close, st_seek, st_tell
+
+.segment "BSS"
+st_ring:    .res 2              ; anillo del programa
+st_pos:     .res 2              ; 0..1023 dentro del anillo
+st_fill:    .res 4              ; bytes válidos por mitad (0 = vacía)
+st_pending: .res 1              ; mitad a recargar o NO_PENDING
+st_flags:   .res 1
+st_half:    .res 1              ; mitad en curso en getc
+st_off:     .res 4              ; posición en el archivo (tell)
+st_skip:    .res 4              ; bytes que faltan en seek
+st_name:    .res 13             ; para reabrir en seek
+
+.segment "CODE"
+
+; Sin stream abierto: getc da fin de archivo
+mod_setup:
+st_clear:
+    lda     #NO_PENDING
+    sta     st_pending
+    lda     #0
+    ldx     #3
+:   sta     st_fill,x
+    dex
+    bpl     :-
+    rts
+
+; ---------------------------------------------------------------------------
+; st_open - $F4-$F5 = nombre, $F6-$F7 = anillo, A = flags
+; ---------------------------------------------------------------------------
+st_open:
+    sta     st_flags
+    lda     $F6
+    sta     st_ring
+    lda     $F7
+    sta     st_ring+1
+    ldy     #0
+:   lda     ($F4),y
+    sta     st_name,y
+    beq     st_reopen
+    iny
+    cpy     #12
+    bne     :-
+    lda     #0
+    sta     st_name,y
+
+; Abrir st_name y llenar las dos mitades desde el principio
+st_reopen:
+    jsr     st_clear
+    lda     #<st_name
+    sta     $F4
+    lda     #>st_name
+    sta     $F5
+    jsr     ROM_MFS_OPEN3
+    cmp     #0
+    bne     @ret
+    sta     st_pos
+    sta     st_pos+1
+    ldx     #3
+:   sta     st_off,x
+    dex
+    bpl     :-
+    jsr     st_refill       ; A = 0: mitad 0
+    lda     st_fill+1
+    cmp     #>HALF_SIZE     ; mitad 0 llena: precargar la 1
+    bne     @ok
+    lda     #1
+    jsr     st_refill
+@ok:
+    lda     #0              ; MFS_OK
+@ret:
+    rts
+
+; ---------------------------------------------------------------------------
+; st_refill - Leer la mitad A (0/1) del anillo; st_fill = bytes leídos
+; ---------------------------------------------------------------------------
+st_refill:
+    pha
+    asl     a
+    clc
+    adc     st_ring+1
+    sta     $F1
+    lda     st_ring
+    sta     $F0
+    lda     #<HALF_SIZE
+    sta     $F2
+    lda     #>HALF_SIZE
+    sta     $F3
+    jsr     ROM_MFS_READ3
+    sta     tmp1
+    stx     tmp2
+    pla
+    asl     a
+    tay
+    lda     tmp1
+    sta     st_fill,y
+    lda     tmp2
+    sta     st_fill+1,y
+    rts
+
+; ---------------------------------------------------------------------------
+; st_getc - Siguiente byte desde RAM. Solo lee la SD si la mitad
+; siguiente sigue pendiente (underrun): la recarga antes, en orden
+; ---------------------------------------------------------------------------
+st_getc:
+    lda     st_pos+1
+    lsr     a
+    sta     st_half
+    asl     a
+    tay
+    lda     st_pos+1        ; desplazamiento en la mitad: bit 0 del alto
+    and     #1
+    cmp     st_fill+1,y
+    bcc     @byte
+    bne     @eof
+    lda     st_pos
+    cmp     st_fill,y
+    bcs     @eof
+@byte:
+    clc
+    lda     st_ring
+    adc     st_pos
+    sta     ptr1
+    lda     st_ring+1
+    adc     st_pos+1
+    sta     ptr1+1
+    ldy     #0
+    lda     (ptr1),y
+    pha
+    inc     st_off
+    bne     :+
+    inc     st_off+1
+    bne     :+
+    inc     st_off+2
+    bne     :+
+    inc     st_off+3
+:   inc     st_pos
+    bne     @done
+    inc     st_pos+1
+    lda     st_pos+1
+    lsr     a
+    bcs     @done           ; mitad de 512 bytes sin terminar
+    and     #1              ; 1024 -> 0: vuelta al principio
+    asl     a
+    sta     st_pos+1
+    jsr     st_poll         ; underrun: la otra mitad sigue pendiente
+    lda     st_half         ; mitad consumida: liberar y dejarla pendiente
+    asl     a
+    tay
+    lda     #0
+    sta     st_fill,y
+    sta     st_fill+1,y
+    lda     st_half
+    sta     st_pending
+    lda     st_flags
+    and     #MFS_STREAM_AUTO
+    beq     @done
+    jsr     st_poll
+@done:
+    pla
+    ldx     #0
+    rts
+@eof:
+    lda     #$FF
+    tax
+    rts
+
+; ---------------------------------------------------------------------------
+; st_poll - Recargar la mitad pendiente
+; ---------------------------------------------------------------------------
+st_poll:
+    lda     st_pending
+    cmp     #NO_PENDING
+    beq     :+
+    ldx     #NO_PENDING
+    stx     st_pending
+    jmp     st_refill
+:   rts
+
+; ---------------------------------------------------------------------------
+; st_close
+; ---------------------------------------------------------------------------
+st_close:
+    jsr     st_clear
+    jmp     ROM_MFS_CLOSE
+
+; ---------------------------------------------------------------------------
+; st_tell - A/X/sreg = st_off
+; ---------------------------------------------------------------------------
+st_tell:
+    lda     st_off+2
+    sta     sreg
+    lda     st_off+3
+    sta     sreg+1
+    lda     st_off
+    ldx     st_off+1
+    rts
+
+; ---------------------------------------------------------------------------
+; st_seek - $F0-$F3 = posición destino
+; ---------------------------------------------------------------------------
+st_seek:
+    ldx     #3
+:   lda     $F0,x
+    sta     st_skip,x
+    dex
+    bpl     :-
+    lda     st_skip         ; destino < posición: reabrir
+    cmp     st_off
+    lda     st_skip+1
+    sbc     st_off+1
+    lda     st_skip+2
+    sbc     st_off+2
+    lda     st_skip+3
+    sbc     st_off+3
+    bcs     @fwd
+    jsr     ROM_MFS_CLOSE
+    jsr     st_reopen
+    cmp     #0
+    bne     @err
+@fwd:
+    sec                     ; st_skip = destino - posición
+    ldx     #0
+    ldy     #4
+:   lda     st_skip,x
+    sbc     st_off,x
+    sta     st_skip,x
+    inx
+    dey
+    bne     :-
+@loop:
+    lda     st_skip
+    ora     st_skip+1
+    ora     st_skip+2
+    ora     st_skip+3
+    beq     @ok
+    jsr     st_getc
+    cpx     #0
+    bne     @err            ; fin de archivo antes del destino
+    lda     st_skip
+    bne     @d0
+    lda     st_skip+1
+    bne     @d1
+    lda     st_skip+2
+    bne     @d2
+    dec     st_skip+3
+@d2:
+    dec     st_skip+2
+@d1:
+    dec     st_skip+1
+@d0:
+    dec     st_skip
+    jmp     @loop
+@ok:
+    lda     #0
+    rts
+@err:
+    lda     #$FF
+    rts
@@ -0,0 +1,96 @@
+/**
+ * ============================================================================
+ * CAT - Overlay del monitor: volcado hex/ASCII de un archivo de la SD
+ * ============================================================================
+ * Uso (con CAT.OVL en la SD):
+ *   CAT nombre [off]
+ *
+ * Muestra hasta 256 bytes desde el offset (hex), 16 por línea. MicroFS
+ * solo lee en secuencia: el offset se salta leyendo.
+ * ============================================================================
+ */
+
+#include <stdint.h>
+#include "../../include/romapi.h"
+
+#define MAX_SHOWN   256
+
+static char name[13];
+static char hex[5];
+static uint8_t buf[16];
+
+static const char *parse_hex(const char *s, uint16_t *v) {
+    uint8_t c;
+
+    *v = 0;
+    while (*s == ' ') s++;
+    while (1) {
+        c = *s;
+        if (c >= '0' && c <= '9') {
+            c -= '0';
+        } else {
+            c |= 0x20;
+            if (c < 'a' || c > 'f') break;
+            c -= 'a' - 10;
+        }
+        *v = (*v << 4) | c;
+        s++;
+    }
+    return s;
+}
+
+/* 4 dígitos, o los 2 bajos si lo pide digits */
+static void put_hex(uint16_t v, uint8_t digits) {
+    rom_u16tohex(v, hex);
+    rom_uart_puts(hex + 4 - digits);
+}
+
+uint8_t ovl_main(const char *args) {
+    uint16_t off, total, n;
+    uint8_t i;
+
+    for (i = 0; i < 12 && *args && *args != ' '; i++) {
+        name[i] = *args++;
+    }
+    name[i] = '\0';
+    parse_hex(args, &off);
+    if (i == 0) {
+        rom_uart_puts("Uso: CAT nombre [off]\r\n");
+        return 0;
+    }
+    if (rom3_mfs_open(name) != MFS_OK) {
+        rom_uart_puts("No encontrado\r\n");
+        return 0;
+    }
+
+    for (total = off; total; total -= n) {
+        n = rom3_mfs_read(buf, total < 16 ? total : 16);
+        if (!n) {
+            rom_mfs_close();
+            rom_uart_puts("Offset fuera de rango\r\n");
+            return 0;
+        }
+    }
+
+    while (total < MAX_SHOWN && (n = rom3_mfs_read(buf, 16)) != 0) {
+        put_hex(off + total, 4);
+        rom_uart_puts(": ");
+        for (i = 0; i < 16; i++) {
+            if (i < n) {
+                put_hex(buf[i], 2);
+                rom_uart_putc(' ');
+            } else {
+                rom_uart_puts("   ");
+            }
+        }
+        rom_uart_putc('|');
+        for (i = 0; i < n; i++) {
+            rom_uart_putc(buf[i] >= 0x20 && buf[i] < 0x7F ? buf[i] : '.');
+        }
+        rom_uart_puts("|\r\n");
+        total += n;
+    }
+
+    rom_mfs_close();
+    return 0;
+}
@@ -0,0 +1,312 @@
+/**
+ * ============================================================================
+ * DD - Overlay del monitor: imagen de sectores SD por UART
+ * ============================================================================
+ * Uso (DDR.OVL y DDW.OVL en la SD, el mismo fuente con DD_WRITE 0/1):
+ *   DDR sec n     SD -> UART (n sectores desde sec)
+ *   DDW sec n     UART -> SD
+ *
+ * sec y n en hex; sec es de 32 bits. El host es scripts/sddd.py.
+ * Trama por sector: STX, seq, 512 bytes, CRC-16/XMODEM (hi, lo). El
+ * receptor responde ACK (siguiente), NAK (reenviar) o CAN (abortar);
+ * EOT cierra. En DDR el sector k+1 se lee mientras el host verifica el
+ * k. El buffer (2 sectores) es $0800-$0BFF de la RAM de usuario: no
+ * cabe en la ventana junto al código, y lo que haya ahí se pierde.
+ * ============================================================================
+ */
+
+#include <stdint.h>
+#include "../../include/romapi.h"
+
+#ifndef DD_WRITE
+#define DD_WRITE    0
+#endif
+
+/* Constantes del protocolo */
+#define DD_STX      0x02
+#define DD_EOT      0x04
+#define DD_ACK      0x06
+#define DD_NAK      0x15
+#define DD_CAN      0x18
+#define DD_REQ      'C'         /* el receptor pide la primera trama */
+#define DD_SECTOR   512
+
+/* Códigos de error */
+#define DD_ERR_TIMEOUT      1
+#define DD_ERR_CANCELLED    2
+#define DD_ERR_SD           3
+#define DD_ERR_RETRIES      4
+
+#define DD_BUF      ((uint8_t *)0x0800)
+#define MAX_RETRIES 10
+
+static char num[11];
+
+/* Tramas reenviadas, en los contadores de STATS ($BE66) */
+static rom_stats_t no_stats;
+static rom_stats_t *st = &no_stats;
+
+/* Parsea hex de hasta 32 bits */
+static const char *parse_hex32(const char *s, uint32_t *v) {
+    uint8_t c;
+
+    *v = 0;
+    while (*s == ' ') s++;
+    while (1) {
+        c = *s;
+        if (c >= '0' && c <= '9') {
+            c -= '0';
+        } else {
+            c |= 0x20;
+            if (c < 'a' || c > 'f') break;
+            c -= 'a' - 10;
+        }
+        *v = (*v << 4) | c;
+        s++;
+    }
+    return s;
+}
+
+/* CRC-16/XMODEM (poly $1021, init 0) sin tabla, por byte */
+static uint16_t dd_crc(const uint8_t *p) {
+    uint16_t crc = 0;
+    uint16_t i;
+
+    for (i = 0; i < DD_SECTOR; i++) {
+        crc = (crc >> 8) | (crc << 8);
+        crc ^= p[i];
+        crc ^= (crc & 0xFF) >> 4;
+        crc ^= crc << 12;
+        crc ^= (crc & 0xFF) << 5;
+    }
+    return crc;
+}
+
+/* Esperar un byte con timeout (~1 s). Retorna -1 si no llega */
+static int dd_wait(void) {
+    uint16_t timeout;
+
+    for (timeout = 0; timeout < 60000; timeout++) {
+        if (rom_uart_rx_ready()) return (uint8_t)rom_uart_getc();
+    }
+    return -1;
+}
+
+#if DD_WRITE
+
+/* Leer n bytes con timeout por byte. Retorna -1 si el host calla */
+static int dd_read(uint8_t *p, uint16_t n) {
+    int c;
+
+    while (n--) {
+        c = dd_wait();
+        if (c < 0) return -1;
+        *p++ = (uint8_t)c;
+    }
+    return 0;
+}
+
+/* UART -> SD. Retorna sectores escritos o -error */
+static long dd_recv(uint32_t start, uint16_t count) {
+    uint8_t *buf = DD_BUF;
+    uint16_t done = 0;
+    uint16_t crc;
+    uint8_t seq;
+    uint8_t crcb[2];
+    uint8_t tries;
+    int c;
+
+    /* Pedir la primera trama con 'C' (máximo 60 intentos) */
+    for (tries = 0; ; tries++) {
+        if (tries >= 60) return -DD_ERR_TIMEOUT;
+        rom_uart_putc(DD_REQ);
+        c = dd_wait();
+        if (c == DD_STX) break;
+        if (c == DD_CAN) return -DD_ERR_CANCELLED;
+    }
+
+    tries = 0;
+    while (1) {
+        /* Trama: seq, datos, CRC (STX ya leído). Cada byte con timeout:
+         * un host que se calla a mitad cuenta como reintento */
+        if (dd_read(&seq, 1) || dd_read(buf, DD_SECTOR) ||
+            dd_read(crcb, 2)) {
+            c = -1;
+        } else {
+            c = 0;
+            crc = ((uint16_t)crcb[0] << 8) | crcb[1];
+        }
+
+        if (c == 0 && seq == (uint8_t)done && crc == dd_crc(buf)) {
+            if (done >= count) {
+                rom_uart_putc(DD_CAN);
+                return (long)done;
+            }
+            /* El ACK sale después de escribir: sin FIFO de RX, una trama
+             * nueva durante la escritura perdería bytes */
+            if (rom_sd_write_sector_via_zp(start + done, buf) != 0) {
+                rom_uart_putc(DD_CAN);
+                return -DD_ERR_SD;
+            }
+            done++;
+            tries = 0;
+            rom_uart_putc(DD_ACK);
+        } else if (c == 0 && seq == (uint8_t)(done - 1)) {
+            rom_uart_putc(DD_ACK);      /* duplicada (se perdió el ACK) */
+        } else {
+            /* Trama corrupta o cortada: NAK hasta MAX_RETRIES */
+            st->dd_retry++;
+            if (++tries >= MAX_RETRIES) {
+                rom_uart_putc(DD_CAN);
+                return -DD_ERR_RETRIES;
+            }
+            rom_uart_putc(DD_NAK);
+        }
+
+        /* Siguiente trama. Sin respuesta, NAK: si el host esperaba un
+         * ACK perdido, reenvía la trama y se reconoce como duplicada */
+        while ((c = dd_wait()) < 0) {
+            if (++tries >= MAX_RETRIES) {
+                rom_uart_putc(DD_CAN);
+                return -DD_ERR_TIMEOUT;
+            }
+            rom_uart_putc(DD_NAK);
+        }
+        if (c == DD_STX) continue;
+        if (c == DD_EOT) {
+            rom_uart_putc(DD_ACK);
+            return (long)done;
+        }
+        if (c == DD_CAN) return -DD_ERR_CANCELLED;
+        return -DD_ERR_TIMEOUT;
+    }
+}
+
+#else
+
+static void dd_frame(uint8_t seq, const uint8_t *p, uint16_t crc) {
+    uint16_t i;
+
+    rom_uart_putc(DD_STX);
+    rom_uart_putc(seq);
+    for (i = 0; i < DD_SECTOR; i++) {
+        rom_uart_putc(p[i]);
+    }
+    rom_uart_putc((uint8_t)(crc >> 8));
+    rom_uart_putc((uint8_t)crc);
+}
+
+/* SD -> UART. Retorna sectores enviados o -error */
+static long dd_send(uint32_t start, uint16_t count) {
+    uint8_t *cur = DD_BUF;
+    uint8_t *nxt = DD_BUF + DD_SECTOR;
+    uint8_t *tmp;
+    uint16_t i;
+    uint16_t crc;
+    uint8_t tries;
+    uint8_t prefetched;
+    int c;
+
+    /* Esperar 'C' del host (máximo 60 timeouts) */
+    for (tries = 0; ; tries++) {
+        if (tries >= 60) return -DD_ERR_TIMEOUT;
+        c = dd_wait();
+        if (c == DD_REQ) break;
+        if (c == DD_CAN) return -DD_ERR_CANCELLED;
+    }
+
+    if (count && rom_sd_read_sector_via_zp(start, cur) != 0) {
+        rom_uart_putc(DD_CAN);
+        return -DD_ERR_SD;
+    }
+
+    for (i = 0; i < count; i++) {
+        crc = dd_crc(cur);
+        prefetched = 0;
+        for (tries = 0; ; tries++) {
+            if (tries >= MAX_RETRIES) {
+                rom_uart_putc(DD_CAN);
+                return -DD_ERR_RETRIES;
+            }
+            if (tries) st->dd_retry++;
+            dd_frame((uint8_t)i, cur, crc);
+
+            /* Leer el siguiente sector mientras el host verifica este */
+            if (!prefetched && i + 1 < count) {
+                if (rom_sd_read_sector_via_zp(start + i + 1, nxt) != 0) {
+                    dd_wait();
+                    rom_uart_putc(DD_CAN);
+                    return -DD_ERR_SD;
+                }
+                prefetched = 1;
+            }
+
+            c = dd_wait();
+            if (c == DD_ACK) break;
+            if (c == DD_CAN) return -DD_ERR_CANCELLED;
+            /* NAK o timeout: reenviar desde el mismo buffer */
+        }
+        tmp = cur;
+        cur = nxt;
+        nxt = tmp;
+    }
+
+    rom_uart_putc(DD_EOT);
+    dd_wait();
+    return (long)count;
+}
+
+#endif
+
+uint8_t ovl_main(const char *args) {
+    uint32_t start, n;
+    uint16_t d;
+    long r;
+
+    if (rom_has_feature2(ROMAPI_FEAT2_STATS)) st = rom_stats();
+
+    args = parse_hex32(args, &start);
+    parse_hex32(args, &n);
+    if (n == 0 || n > 0xFFFF) {
+        rom_uart_puts(DD_WRITE ? "Uso: DDW sec n\r\n" : "Uso: DDR sec n\r\n");
+        return 1;
+    }
+
+    rom_uart_puts(DD_WRITE ? "DDW sector $" : "DDR sector $");
+    rom_u16tohex((uint16_t)(start >> 16), num);
+    rom_uart_puts(num);
+    rom_u16tohex((uint16_t)start, num);
+    rom_uart_puts(num);
+    rom_uart_puts(" n=");
+    rom_u16toa((uint16_t)n, num);
+    rom_uart_puts(num);
+    rom_uart_puts("\r\n");
+
+#if DD_WRITE
+    r = dd_recv(start, (uint16_t)n);
+#else
+    r = dd_send(start, (uint16_t)n);
+#endif
+
+    /* Limpiar buffer UART */
+    for (d = 0; d < 30000; d++);
+    while (rom_uart_rx_ready()) rom_uart_getc();
+
+#if DD_WRITE
+    /* Puede haber reescrito el directorio: releer el índice */
+    rom_mfs_mount();
+#endif
+
+    if (r < 0) {
+        rom_uart_puts("\r\nError DD: ");
+        rom_u16tohex((uint16_t)-r, num);
+        rom_uart_puts(num + 2);
+        rom_uart_puts("\r\n");
+        return 1;
+    }
+    rom_uart_puts("\r\nOK: ");
+    rom_u16toa((uint16_t)r, num);
+    rom_uart_puts(num);
+    rom_uart_puts(" sectores\r\n");
+    return 0;
+}
@@ -0,0 +1,186 @@
+/**
+ * ============================================================================
+ * DISASM - Overlay del monitor: desensamblador básico
+ * ============================================================================
+ * Uso (con DISASM.OVL en la SD; el comando M de la ROM lo llama):
+ *   M [dir] [n]
+ *
+ * n instrucciones (hex, por omisión 16, máximo FF). Sin dirección sigue
+ * donde quedó el monitor, y al volver la deja tras la última. La tabla
+ * de mnemónicos es la del monitor original: solo las instrucciones
+ * comunes, el resto sale como "???".
+ * ============================================================================
+ */
+
+#include <stdint.h>
+#include "../../include/romapi.h"
+
+/* Dirección actual del monitor (cabecera, ovl_head.s) */
+extern uint16_t ovl_addr;
+
+static char hex[5];
+
+static const char *parse_hex(const char *s, uint16_t *v) {
+    uint8_t c;
+
+    *v = 0;
+    while (*s == ' ') s++;
+    while (1) {
+        c = *s;
+        if (c >= '0' && c <= '9') {
+            c -= '0';
+        } else {
+            c |= 0x20;
+            if (c < 'a' || c > 'f') break;
+            c -= 'a' - 10;
+        }
+        *v = (*v << 4) | c;
+        s++;
+    }
+    return s;
+}
+
+/* 4 dígitos, o los 2 bajos si lo pide digits */
+static void put_hex(uint16_t v, uint8_t digits) {
+    rom_u16tohex(v, hex);
+    rom_uart_puts(hex + 4 - digits);
+}
+
+/* Tabla simplificada de mnemonics (solo instrucciones comunes) */
+static const char* get_mnemonic(uint8_t opcode) {
+    switch (opcode) {
+        case 0x00: return "BRK";
+        case 0x20: return "JSR";
+        case 0x40: return "RTI";
+        case 0x60: return "RTS";
+        case 0x4C: return "JMP";
+        case 0x6C: return "JMP()";
+        case 0xA9: return "LDA#";
+        case 0xA5: return "LDAzp";
+        case 0xAD: return "LDAab";
+        case 0xA2: return "LDX#";
+        case 0xA0: return "LDY#";
+        case 0x85: return "STAzp";
+        case 0x8D: return "STAab";
+        case 0x86: return "STXzp";
+        case 0x84: return "STYzp";
+        case 0xE8: return "INX";
+        case 0xC8: return "INY";
+        case 0xCA: return "DEX";
+        case 0x88: return "DEY";
+        case 0x18: return "CLC";
+        case 0x38: return "SEC";
+        case 0xD8: return "CLD";
+        case 0xF8: return "SED";
+        case 0x58: return "CLI";
+        case 0x78: return "SEI";
+        case 0xEA: return "NOP";
+        case 0xAA: return "TAX";
+        case 0xA8: return "TAY";
+        case 0x8A: return "TXA";
+        case 0x98: return "TYA";
+        case 0x9A: return "TXS";
+        case 0xBA: return "TSX";
+        case 0x48: return "PHA";
+        case 0x68: return "PLA";
+        case 0x08: return "PHP";
+        case 0x28: return "PLP";
+        case 0x69: return "ADC#";
+        case 0xE9: return "SBC#";
+        case 0xC9: return "CMP#";
+        case 0xE0: return "CPX#";
+        case 0xC0: return "CPY#";
+        case 0x29: return "AND#";
+        case 0x09: return "ORA#";
+        case 0x49: return "EOR#";
+        case 0xD0: return "BNE";
+        case 0xF0: return "BEQ";
+        case 0x10: return "BPL";
+        case 0x30: return "BMI";
+        case 0x90: return "BCC";
+        case 0xB0: return "BCS";
+        case 0x50: return "BVC";
+        case 0x70: return "BVS";
+        default:   return "???";
+    }
+}
+
+/* Bytes por instrucción (simplificado) */
+static uint8_t get_instruction_len(uint8_t opcode) {
+    /* Implied/Accumulator - 1 byte */
+    if (opcode == 0x00 || opcode == 0x40 || opcode == 0x60 ||
+        opcode == 0xE8 || opcode == 0xC8 || opcode == 0xCA ||
+        opcode == 0x88 || opcode == 0x18 || opcode == 0x38 ||
+        opcode == 0xD8 || opcode == 0xF8 || opcode == 0x58 ||
+        opcode == 0x78 || opcode == 0xEA || opcode == 0xAA ||
+        opcode == 0xA8 || opcode == 0x8A || opcode == 0x98 ||
+        opcode == 0x9A || opcode == 0xBA || opcode == 0x48 ||
+        opcode == 0x68 || opcode == 0x08 || opcode == 0x28) {
+        return 1;
+    }
+
+    /* Immediate, Zero Page, Relative - 2 bytes */
+    if ((opcode & 0x0F) == 0x09 || /* Immediate */
+        (opcode & 0x0F) == 0x05 || /* Zero Page */
+        (opcode & 0x0F) == 0x06 || /* Zero Page */
+        (opcode & 0x1F) == 0x10 || /* Branches */
+        opcode == 0xA2 || opcode == 0xA0 ||
+        opcode == 0xE0 || opcode == 0xC0) {
+        return 2;
+    }
+
+    /* Absolute, Indirect - 3 bytes */
+    if (opcode == 0x20 || opcode == 0x4C || opcode == 0x6C ||
+        (opcode & 0x0F) == 0x0D || /* Absolute */
+        (opcode & 0x0F) == 0x0E) {
+        return 3;
+    }
+
+    /* Por defecto asumir 2 bytes */
+    return 2;
+}
+
+uint8_t ovl_main(const char *args) {
+    uint16_t addr, n;
+    uint8_t i, j, len;
+    const uint8_t *p;
+
+    args = parse_hex(args, &addr);
+    parse_hex(args, &n);
+    if (!addr) addr = ovl_addr;
+    if (!n) n = 16;
+    if (n > 255) {
+        rom_uart_puts("Max 255 (FF) lineas\r\n");
+        n = 255;
+    }
+
+    for (i = 0; i < (uint8_t)n; i++) {
+        p = (const uint8_t *)addr;
+        len = get_instruction_len(p[0]);
+
+        put_hex(addr, 4);
+        rom_uart_puts("  ");
+        for (j = 0; j < 3; j++) {
+            if (j < len) {
+                put_hex(p[j], 2);
+            } else {
+                rom_uart_puts("  ");
+            }
+            rom_uart_putc(' ');
+        }
+
+        rom_uart_puts(get_mnemonic(p[0]));
+        if (len == 2) {
+            rom_uart_puts(" $");
+            put_hex(p[1], 2);
+        } else if (len == 3) {
+            rom_uart_puts(" $");
+            put_hex(p[2] << 8 | p[1], 4);
+        }
+        rom_uart_puts("\r\n");
+        addr += len;
+    }
+
+    ovl_addr = addr;
+    return 0;
+}
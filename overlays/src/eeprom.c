@@ -0,0 +1,305 @@
+/**
+ * ============================================================================
+ * EEPROM - Overlay del monitor: configuración e imagen en EEPROM I2C
+ * ============================================================================
+ * Uso (con EEPROM.OVL en la SD y el módulo I2CBLK.X65 residente):
+ *   EEPROM                    listar la configuración
+ *   EEPROM CLAVE=valor        guardar (CLAVE= la borra)
+ *   EEPROM SAVE dir n [ent]   grabar dir..dir+n-1 como imagen
+ *   EEPROM LOAD               cargar la imagen; R la ejecuta
+ *
+ * EEPROM serie tipo 24Cxx (dirección interna de 2 bytes) en el
+ * controlador I2C de $C010-$C014, leída y escrita con las transferencias
+ * en bloque de $BE60/$BE63 (páginas de EE_PAGE con ACK polling):
+ *
+ *   EE_CFG_ADDR  "EC", bytes usados, registros [klen][vlen][clave][valor]
+ *   EE_IMG_ADDR  cabecera ee_img_t + imagen de un programa pequeño
+ *
+ * Claves en mayúsculas (hasta EE_KEY_MAX), valores de texto (hasta
+ * EE_VAL_MAX). La cabecera se graba la última: una escritura cortada
+ * deja la configuración o la imagen anteriores.
+ * ============================================================================
+ */
+
+#include <stdint.h>
+#include "../../include/romapi.h"
+
+/* Dirección actual del monitor (cabecera, ovl_head.s) */
+extern uint16_t ovl_addr;
+
+#define EE_DEV          0x50    /* A2..A0 a masa */
+#define EE_PAGE         32      /* 24C32/24C64; 64 en 24C256 */
+#define EE_SIZE         4096    /* capacidad mínima soportada (24C32) */
+
+#define EE_CFG_ADDR     0x0000
+#define EE_CFG_SIZE     256
+#define EE_IMG_ADDR     (EE_CFG_ADDR + EE_CFG_SIZE)
+#define EE_IMG_MAX      (EE_SIZE - EE_IMG_ADDR - sizeof(ee_img_t))
+
+#define EE_KEY_MAX      8
+#define EE_VAL_MAX      32
+
+#define EE_HDR          3       /* "EC" + bytes usados */
+#define EE_REC_MAX      (EE_CFG_SIZE - EE_HDR)
+#define EE_REC_BASE     (EE_CFG_ADDR + EE_HDR)
+
+#define RAM_START       0x0800
+#define RAM_END         0x3600  /* ventana de overlays */
+
+/* Cabecera de la imagen (little-endian) */
+typedef struct {
+    uint16_t load;
+    uint16_t len;               /* 0 o $FFFF (borrada) = sin imagen */
+    uint16_t entry;
+    uint16_t sum;               /* suma de 16 bits de los bytes */
+} ee_img_t;
+
+static uint8_t ee_used;         /* bytes de registros */
+static uint8_t ee_hdr[EE_HDR];
+static uint8_t ee_buf[2 + EE_KEY_MAX + EE_VAL_MAX];
+static char key[EE_KEY_MAX + 1];
+static char val[EE_VAL_MAX + 1];
+static char num[6];
+
+static const char *parse_hex(const char *s, uint16_t *v) {
+    uint8_t c;
+
+    *v = 0;
+    while (*s == ' ') s++;
+    while (1) {
+        c = *s;
+        if (c >= '0' && c <= '9') {
+            c -= '0';
+        } else {
+            c |= 0x20;
+            if (c < 'a' || c > 'f') break;
+            c -= 'a' - 10;
+        }
+        *v = (*v << 4) | c;
+        s++;
+    }
+    return s;
+}
+
+/* Primera palabra de s igual a w (en mayúsculas) */
+static uint8_t word_eq(const char *s, const char *w) {
+    char c;
+
+    while (*w) {
+        c = *s++;
+        if (c >= 'a' && c <= 'z') c -= 32;
+        if (c != *w++) return 0;
+    }
+    return *s == ' ' || *s == '\0';
+}
+
+/* Mostrar msg (0 = fallo del bus) y retornar 1 */
+static uint8_t ee_fail(const char *msg) {
+    rom_uart_puts(msg ? msg : "Error EEPROM\r\n");
+    return 1;
+}
+
+static uint8_t ee_read(uint16_t addr, void *buf, uint16_t len) {
+    return rom_i2c_read_buf(EE_DEV, 2, addr, buf, len) == len;
+}
+
+static uint8_t ee_write(uint16_t addr, const void *buf, uint16_t len) {
+    return rom_i2c_write_buf(EE_DEV, 2, addr, buf, len, EE_PAGE) == len;
+}
+
+static uint16_t sum16(const uint8_t *p, uint16_t len) {
+    uint16_t s = 0;
+
+    while (len--) s += *p++;
+    return s;
+}
+
+/* Bytes usados según la cabecera; una EEPROM nueva ($FF) cuenta como vacía */
+static uint8_t ee_load_used(void) {
+    if (ee_hdr[0] != 'E' || ee_hdr[1] != 'C' || ee_hdr[2] > EE_REC_MAX) return 0;
+    return ee_hdr[2];
+}
+
+/* Siguiente registro desde *pos en key/val. Retorna 0 al terminar */
+static uint8_t ee_next(uint8_t *pos) {
+    uint8_t klen, vlen, i;
+    uint16_t a;
+
+    if ((uint16_t)*pos + 2 > ee_used) return 0;
+    a = EE_REC_BASE + *pos;
+    if (!ee_read(a, ee_buf, 2)) return 0;
+    klen = ee_buf[0];
+    vlen = ee_buf[1];
+    /* Registro corrupto: se trata como fin de la lista */
+    if (!klen || klen > EE_KEY_MAX || vlen > EE_VAL_MAX ||
+        (uint16_t)*pos + 2 + klen + vlen > ee_used) return 0;
+    if (!ee_read(a + 2, ee_buf, klen + vlen)) return 0;
+
+    for (i = 0; i < klen; i++) key[i] = ee_buf[i];
+    key[klen] = '\0';
+    for (i = 0; i < vlen; i++) val[i] = ee_buf[klen + i];
+    val[vlen] = '\0';
+    *pos += 2 + klen + vlen;
+    return 1;
+}
+
+static uint8_t str_eq(const char *a, const char *b) {
+    while (*a && *a == *b) {
+        a++;
+        b++;
+    }
+    return *a == *b;
+}
+
+/* k = v; v vacío borra. Retorna 0, o 1 con el error ya mostrado */
+static uint8_t ee_set(const char *k, const char *v) {
+    uint8_t klen = 0;
+    uint8_t vlen = 0;
+    uint8_t pos = 0;
+    uint8_t at = 0;
+    uint8_t n, i;
+
+    while (k[klen]) klen++;
+    while (v[vlen]) vlen++;
+    if (!klen || klen > EE_KEY_MAX || vlen > EE_VAL_MAX)
+        return ee_fail("Clave o valor demasiado largos\r\n");
+
+    /* Registro anterior de la clave: [at, pos) */
+    while (ee_next(&pos)) {
+        if (str_eq(key, k)) break;
+        at = pos;
+    }
+    if (at == pos) at = pos = ee_used;
+    if ((uint16_t)ee_used - (pos - at) + (vlen ? 2 + klen + vlen : 0) > EE_REC_MAX)
+        return ee_fail("Configuracion llena\r\n");
+
+    /* Quitarlo desplazando los siguientes */
+    while (pos < ee_used) {
+        n = ee_used - pos;
+        if (n > sizeof(ee_buf)) n = sizeof(ee_buf);
+        if (!ee_read(EE_REC_BASE + pos, ee_buf, n) ||
+            !ee_write(EE_REC_BASE + at, ee_buf, n)) return ee_fail(0);
+        at += n;
+        pos += n;
+    }
+
+    /* Añadir al final y, por último, la cabecera con la nueva longitud */
+    if (vlen) {
+        ee_buf[0] = klen;
+        ee_buf[1] = vlen;
+        for (i = 0; i < klen; i++) ee_buf[2 + i] = k[i];
+        for (i = 0; i < vlen; i++) ee_buf[2 + klen + i] = v[i];
+        if (!ee_write(EE_REC_BASE + at, ee_buf, 2 + klen + vlen))
+            return ee_fail(0);
+        at += 2 + klen + vlen;
+    }
+    ee_hdr[0] = 'E';
+    ee_hdr[1] = 'C';
+    ee_hdr[2] = at;
+    if (!ee_write(EE_CFG_ADDR, ee_hdr, EE_HDR)) return ee_fail(0);
+    rom_uart_puts("OK\r\n");
+    return 0;
+}
+
+/* Alguna ranura de extensión apunta a las páginas lo..hi */
+static uint8_t hits_module(uint8_t lo, uint8_t hi) {
+    const uint8_t *v = (const uint8_t *)ROMAPI_EXT_VEC_ADDR;
+    uint8_t i;
+
+    for (i = 0; i < ROMAPI_X_COUNT; i++) {
+        if (v[i * 2 + 1] >= lo && v[i * 2 + 1] <= hi) return 1;
+    }
+    return 0;
+}
+
+/* Imagen dentro de $0800-$35FF, sin pisar módulos, entrada dentro */
+static uint8_t img_ok(const ee_img_t *img) {
+    return img->len && img->len <= EE_IMG_MAX &&
+        img->load >= RAM_START && img->load < RAM_END &&
+        img->len <= RAM_END - img->load &&
+        img->entry >= img->load && img->entry - img->load < img->len &&
+        !hits_module((uint8_t)(img->load >> 8),
+                     (uint8_t)((img->load + img->len - 1) >> 8));
+}
+
+static void put_len(uint16_t n) {
+    rom_u16toa(n, num);
+    rom_uart_puts(num);
+    rom_uart_puts(" bytes\r\n");
+}
+
+/* SAVE dir n [ent] */
+static uint8_t cmd_save(const char *args) {
+    ee_img_t img;
+
+    args = parse_hex(args, &img.load);
+    args = parse_hex(args, &img.len);
+    parse_hex(args, &img.entry);
+    if (!img.entry) img.entry = img.load;
+    if (!img_ok(&img)) return ee_fail("Uso: EEPROM SAVE dir n [ent]\r\n");
+
+    img.sum = sum16((const uint8_t *)img.load, img.len);
+    /* La cabecera al final: una grabación cortada no deja imagen válida */
+    if (!ee_write(EE_IMG_ADDR + sizeof(ee_img_t), (const void *)img.load,
+                  img.len) ||
+        !ee_write(EE_IMG_ADDR, &img, sizeof(ee_img_t))) return ee_fail(0);
+    rom_uart_puts("Grabados ");
+    put_len(img.len);
+    return 0;
+}
+
+/* LOAD: imagen a RAM, entrada como dirección actual del monitor */
+static uint8_t cmd_load(void) {
+    ee_img_t img;
+
+    if (!ee_read(EE_IMG_ADDR, &img, sizeof(ee_img_t))) return ee_fail(0);
+    if (!img_ok(&img)) return ee_fail("Sin imagen\r\n");
+    if (!ee_read(EE_IMG_ADDR + sizeof(ee_img_t), (void *)img.load, img.len))
+        return ee_fail(0);
+    if (sum16((const uint8_t *)img.load, img.len) != img.sum)
+        return ee_fail("Suma incorrecta\r\n");
+    ovl_addr = img.entry;
+    rom_uart_puts("Cargados ");
+    put_len(img.len);
+    return 0;
+}
+
+uint8_t ovl_main(const char *args) {
+    char k[EE_KEY_MAX + 1];
+    uint8_t pos = 0;
+    uint8_t i = 0;
+
+    if (!((uint16_t)rom_ext_features() & ROMAPI_FEAT_BUSBLK)) {
+        rom_uart_puts("Falta el modulo I2CBLK.X65\r\n");
+        return 1;
+    }
+    rom_i2c_init();
+    if (!ee_read(EE_CFG_ADDR, ee_hdr, EE_HDR)) return ee_fail(0);
+    ee_used = ee_load_used();
+
+    while (*args == ' ') args++;
+    if (!*args) {
+        while (ee_next(&pos)) {
+            rom_uart_puts("  ");
+            rom_uart_puts(key);
+            rom_uart_putc('=');
+            rom_uart_puts(val);
+            rom_uart_puts("\r\n");
+        }
+        if (!pos) rom_uart_puts("Vacia\r\n");
+        return 0;
+    }
+
+    if (word_eq(args, "SAVE")) return cmd_save(args + 4);
+    if (word_eq(args, "LOAD")) return cmd_load();
+
+    /* CLAVE=valor; la clave se guarda en mayúsculas */
+    while (*args && *args != '=' && i < EE_KEY_MAX) {
+        k[i] = *args++;
+        if (k[i] >= 'a' && k[i] <= 'z') k[i] -= 32;
+        i++;
+    }
+    k[i] = '\0';
+    if (*args++ != '=') return ee_fail("Uso: EEPROM [CLAVE=valor]\r\n");
+    return ee_set(k, args);
+}
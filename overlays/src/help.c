@@ -0,0 +1,81 @@
+/**
+ * ============================================================================
+ * HELP - Overlay del monitor: ayuda detallada por comando
+ * ============================================================================
+ * Uso (con HELP.OVL en la SD; H y ? de la ROM lo llaman con argumento):
+ *   H cmd
+ *
+ * H sin argumento es la ayuda general de la ROM. Los textos son los que
+ * la ROM traía antes de quedarse sin sitio, más los de los overlays.
+ * ============================================================================
+ */
+
+#include <stdint.h>
+#include "../../include/romapi.h"
+
+/* Pares nombre, texto; termina en 0 */
+static const char * const help[] = {
+    "R",        "R [dir] Run\r\n"
+                "Dir default: la ultima usada\r\n"
+                "Terminar con RTS\r\n",
+    "RD",       "RD [dir] Leer byte\r\n",
+    "W",        "W dir val Escribir\r\n",
+    "D",        "D dir [n] Dump hex\r\n"
+                "n default=64\r\n",
+    "L",        "L [dir] Carga hex int\r\n"
+                "Escribe bytes, '.' fin (HEXLOAD.OVL)\r\n",
+    "F",        "F dir n val Fill\r\n",
+    "M",        "M [dir] [n] Desensamblar\r\n"
+                "n=instrucciones (def 16, DISASM.OVL)\r\n",
+    "I",        "I - Info mapa memoria y arranque\r\n",
+    "Q",        "Q - Reset\r\n",
+    "H",        "H [cmd] Ayuda (general o del comando)\r\n",
+    "SD",       "SD - Inicializar SD\r\n",
+    "LS",       "LS - Listar archivos\r\n",
+    "SAVE",     "SAVE file dir n Guardar\r\n",
+    "LOAD",     "LOAD file [dir] Cargar\r\n"
+                "Cabecera X65: dir y entrada de la imagen\r\n",
+    "DEL",      "DEL file Eliminar\r\n",
+    "CAT",      "CAT file [off] Ver hex\r\n",
+    "SDFMT",    "SDFMT Formatear SD\r\n",
+    "XRECV",    "XRECV [dir] XMODEM\r\n",
+    "RAMTEST",  "RAMTEST dir n Probar RAM\r\n",
+    "DDR",      "DDR sec n SD->UART\r\n"
+                "Usa $0800-$0BFF. Host: sddd.py\r\n",
+    "DDW",      "DDW sec n UART->SD\r\n"
+                "Usa $0800-$0BFF. Host: sddd.py\r\n",
+    "UNLZ",     "UNLZ file [dir] Cargar LZ65\r\n"
+                "Dir default $0800. Requiere LZ.X65\r\n",
+    "RLOAD",    "RLOAD file [dir] Cargar reubicable\r\n"
+                "dir = pagina; default la del X65\r\n",
+    "EEPROM",   "EEPROM [CLAVE=valor] Config I2C\r\n"
+                "SAVE dir n [ent] / LOAD: imagen\r\n"
+                "Requiere I2CBLK.X65\r\n",
+    "STATS",    "STATS [CLR] Contadores de errores\r\n",
+    0
+};
+
+/* Primera palabra de cmd igual a name, sin distinguir mayúsculas */
+static uint8_t word_eq(const char *cmd, const char *name) {
+    char c;
+
+    while (*name) {
+        c = *cmd++;
+        if (c >= 'a' && c <= 'z') c -= 32;
+        if (c != *name++) return 0;
+    }
+    return *cmd == ' ' || *cmd == '\0';
+}
+
+uint8_t ovl_main(const char *args) {
+    const char * const *h;
+
+    for (h = help; *h; h += 2) {
+        if (word_eq(args, h[0])) {
+            rom_uart_puts(h[1]);
+            return 0;
+        }
+    }
+    rom_uart_puts("Cmd desconocido\r\n");
+    return 0;
+}
@@ -0,0 +1,99 @@
+/**
+ * ============================================================================
+ * HEXLOAD - Overlay del monitor: carga de bytes en hex desde la consola
+ * ============================================================================
+ * Uso (con HEXLOAD.OVL en la SD; el comando L de la ROM lo llama):
+ *   L [dir]
+ *
+ * Sin dirección sigue donde quedó el monitor. Recibe pares de dígitos
+ * hex separados o no por espacios, en varias líneas, y termina con '.'.
+ * Al volver, la dirección actual del monitor queda tras el último byte.
+ * No escribe en la ventana de overlays ($3600-$3DFF): es este código.
+ * ============================================================================
+ */
+
+#include <stdint.h>
+#include "../../include/romapi.h"
+
+/* Dirección actual del monitor (cabecera, ovl_head.s) */
+extern uint16_t ovl_addr;
+
+static char hex[5];
+
+static const char *parse_hex(const char *s, uint16_t *v) {
+    uint8_t c;
+
+    *v = 0;
+    while (*s == ' ') s++;
+    while (1) {
+        c = *s;
+        if (c >= '0' && c <= '9') {
+            c -= '0';
+        } else {
+            c |= 0x20;
+            if (c < 'a' || c > 'f') break;
+            c -= 'a' - 10;
+        }
+        *v = (*v << 4) | c;
+        s++;
+    }
+    return s;
+}
+
+static void put_hex(uint16_t v) {
+    rom_u16tohex(v, hex);
+    rom_uart_puts(hex);
+}
+
+/* Valor del dígito hex, o 0xFF */
+static uint8_t hex_val(uint8_t c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    c |= 0x20;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return 0xFF;
+}
+
+uint8_t ovl_main(const char *args) {
+    uint16_t addr;
+    uint16_t loaded = 0;
+    uint8_t byte_val = 0;
+    uint8_t nibbles = 0;
+    uint8_t c, v;
+
+    parse_hex(args, &addr);
+    if (!addr) addr = ovl_addr;
+
+    rom_uart_puts("Modo carga en $");
+    put_hex(addr);
+    rom_uart_puts(" (terminar con '.')\r\n:");
+
+    while ((c = rom_uart_getc()) != '.') {
+        if (c == '\r' || c == '\n') {
+            rom_uart_puts("\r\n:");
+            continue;
+        }
+        v = hex_val(c);
+        if (v == 0xFF) {
+            if (c == ' ') rom_uart_putc(' ');
+            continue;
+        }
+        rom_uart_putc(c);
+        byte_val = (byte_val << 4) | v;
+        if (++nibbles == 2) {
+            if (addr >= 0x3600 && addr <= 0x3DFF) {
+                rom_uart_puts("\r\nVentana de overlays\r\n");
+                break;
+            }
+            *(uint8_t *)addr++ = byte_val;
+            loaded++;
+            byte_val = 0;
+            nibbles = 0;
+        }
+    }
+
+    rom_uart_puts("\r\nCargados $");
+    put_hex(loaded);
+    rom_uart_puts(" bytes\r\n");
+    ovl_addr = addr;
+    return 0;
+}
@@ -0,0 +1,56 @@
+; ============================================
+; ovl_head.s - Cabecera de overlay del monitor
+; ============================================
+; El monitor la verifica antes de saltar (libs/monitor/monitor.h):
+;   +0 "OV"   +2 versión ABI   +3 JMP entrada
+;   +6 ovl_addr: el monitor escribe aquí su última dirección antes de
+;      llamar y la lee al volver (M y L siguen donde quedaron)
+; Entrada: uint8_t ovl_main(const char *args), args en AX
+; (resto de la línea de comando). Retorna MON_OK (0); cualquier
+; otro valor el monitor lo toma como MON_ERROR
+; ============================================
+
+.export _ovl_addr
+
+.import _ovl_main
+.import __BSS_RUN__, __OVL_START__, __OVL_SIZE__
+.importzp ptr1
+
+MON_OVL_ABI = 2
+
+.segment "OVLHDR"
+
+    .byte "OV"
+    .byte MON_OVL_ABI
+    jmp ovl_start
+_ovl_addr:
+    .word 0
+
+.segment "CODE"
+
+; BSS a cero: el monitor solo lee el archivo. El BSS llega hasta el
+; final de la ventana, que acaba en un límite de página
+ovl_start:
+    pha
+    txa
+    pha
+    lda #<__BSS_RUN__
+    sta ptr1
+    lda #>__BSS_RUN__
+    sta ptr1+1
+    ldy #0
+@clr:
+    lda ptr1+1
+    cmp #>(__OVL_START__ + __OVL_SIZE__)
+    bcs @done
+    tya
+    sta (ptr1),y
+    inc ptr1
+    bne @clr
+    inc ptr1+1
+    bne @clr
+@done:
+    pla
+    tax
+    pla
+    jmp _ovl_main
@@ -0,0 +1,106 @@
+/**
+ * ============================================================================
+ * RAMTEST - Overlay del monitor: prueba de RAM no destructiva
+ * ============================================================================
+ * Uso (con RAMTEST.OVL en la SD):
+ *   RAMTEST dir n
+ *
+ * Por cada byte: guarda el valor, escribe $55 y $AA, verifica y lo
+ * restaura. Muestra las primeras 8 direcciones con fallo y el total.
+ * Rechaza los rangos que están en uso mientras corre: la ZP del
+ * monitor ($02-$27, con sp y los registros de CC65), la ventana de
+ * overlays ($3600-$3DFF) y el stack de CC65 ($3E00-$3FF1).
+ * ============================================================================
+ */
+
+#include <stdint.h>
+#include "../../include/romapi.h"
+
+#define MAX_SHOWN   8
+
+/* Rangos en uso (inclusivos) */
+static const uint16_t busy[] = {
+    0x0002, 0x0027,     /* ZP del monitor */
+    0x3600, 0x3DFF,     /* ventana de overlays */
+    0x3E00, 0x3FF1      /* stack de CC65 */
+};
+
+static char hex[5];
+
+static const char *parse_hex(const char *s, uint16_t *v) {
+    uint8_t c;
+
+    *v = 0;
+    while (*s == ' ') s++;
+    while (1) {
+        c = *s;
+        if (c >= '0' && c <= '9') {
+            c -= '0';
+        } else {
+            c |= 0x20;
+            if (c < 'a' || c > 'f') break;
+            c -= 'a' - 10;
+        }
+        *v = (*v << 4) | c;
+        s++;
+    }
+    return s;
+}
+
+static void put_hex(uint16_t v) {
+    rom_u16tohex(v, hex);
+    rom_uart_puts(hex);
+}
+
+/* 1 si el byte no retiene $55 o $AA; siempre lo restaura */
+static uint8_t test_byte(volatile uint8_t *p) {
+    uint8_t save = *p;
+    uint8_t bad;
+
+    *p = 0x55;
+    bad = (*p != 0x55);
+    *p = 0xAA;
+    bad |= (*p != 0xAA);
+    *p = save;
+    return bad;
+}
+
+uint8_t ovl_main(const char *args) {
+    uint16_t addr, len, end;
+    uint16_t errors = 0;
+    uint8_t i;
+
+    args = parse_hex(args, &addr);
+    parse_hex(args, &len);
+    end = addr + len - 1;
+    if (len == 0 || end < addr) {
+        rom_uart_puts("Uso: RAMTEST dir n\r\n");
+        return 0;
+    }
+    for (i = 0; i < sizeof(busy) / sizeof(busy[0]); i += 2) {
+        if (addr <= busy[i + 1] && end >= busy[i]) {
+            rom_uart_puts("Rango en uso: $");
+            put_hex(busy[i]);
+            rom_uart_puts("-$");
+            put_hex(busy[i + 1]);
+            rom_uart_puts("\r\n");
+            return 0;
+        }
+    }
+
+    for (; len; addr++, len--) {
+        if (test_byte((volatile uint8_t *)addr)) {
+            if (errors < MAX_SHOWN) {
+                rom_uart_puts("Fallo $");
+                put_hex(addr);
+                rom_uart_puts("\r\n");
+            }
+            errors++;
+        }
+    }
+
+    rom_uart_puts("Errores: $");
+    put_hex(errors);
+    rom_uart_puts("\r\n");
+    return 0;
+}
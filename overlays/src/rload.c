@@ -0,0 +1,193 @@
+/**
+ * ============================================================================
+ * RLOAD - Overlay del monitor: carga de ejecutables X65 reubicables
+ * ============================================================================
+ * Uso (con RLOAD.OVL en la SD):
+ *   RLOAD nombre [dir]
+ *
+ * Carga un X65 generado con mkexe.py --reloc (flag bit 1) en la página
+ * dir (por defecto, la de la cabecera), verifica el CRC-32 de la imagen
+ * tal como se enlazó y suma (página destino - página de load) a cada
+ * byte de la tabla que sigue al cuerpo, en una pasada leída de la SD.
+ * Deja la entrada como dirección actual del monitor: R la ejecuta, y
+ * R dir la vuelve a lanzar sin recargar mientras nadie pise sus páginas.
+ * Varios programas pueden quedar cargados a la vez en páginas distintas.
+ *
+ * La imagen debe quedar en $0800-$35FF (la ventana es este código) y no
+ * pisar un módulo residente con ranuras registradas.
+ * ============================================================================
+ */
+
+#include <stdint.h>
+#include "../../include/romapi.h"
+
+/* Dirección actual del monitor (cabecera, ovl_head.s) */
+extern uint16_t ovl_addr;
+
+#define EXE_FORMAT      1
+#define EXE_FLAG_RELOC  0x02
+#define RAM_START       0x0800
+#define RAM_END         0x3600      /* ventana de overlays */
+
+/* Cabecera X65 (scripts/mkexe.py) */
+typedef struct {
+    char     magic[3];
+    uint8_t  format;
+    uint8_t  romapi;
+    uint8_t  flags;
+    uint16_t load;
+    uint16_t entry;
+    uint16_t len;
+    uint32_t crc;
+} exe_hdr_t;
+
+static exe_hdr_t hdr;
+static char name[13];
+static char num[6];
+static uint8_t tbl[16];
+
+static const char *parse_hex(const char *s, uint16_t *v) {
+    uint8_t c;
+
+    *v = 0;
+    while (*s == ' ') s++;
+    while (1) {
+        c = *s;
+        if (c >= '0' && c <= '9') {
+            c -= '0';
+        } else {
+            c |= 0x20;
+            if (c < 'a' || c > 'f') break;
+            c -= 'a' - 10;
+        }
+        *v = (*v << 4) | c;
+        s++;
+    }
+    return s;
+}
+
+static void put_hex(uint16_t v) {
+    rom_u16tohex(v, num);
+    rom_uart_puts(num);
+}
+
+/* CRC-32 (zlib) bit a bit, como el de la ROM */
+static uint32_t crc32(const uint8_t *p, uint16_t n) {
+    uint32_t crc = 0xFFFFFFFFUL;
+    uint8_t k;
+
+    while (n--) {
+        crc ^= *p++;
+        for (k = 0; k < 8; k++) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320UL : crc >> 1;
+        }
+    }
+    return ~crc;
+}
+
+/* Alguna ranura de extensión apunta a las páginas lo..hi */
+static uint8_t hits_module(uint8_t lo, uint8_t hi) {
+    const uint8_t *v = (const uint8_t *)ROMAPI_EXT_VEC_ADDR;
+    uint8_t i;
+
+    for (i = 0; i < ROMAPI_X_COUNT; i++) {
+        if (v[i * 2 + 1] >= lo && v[i * 2 + 1] <= hi) return 1;
+    }
+    return 0;
+}
+
+/* Aplicar la tabla leyéndola de la SD. Retorna bytes corregidos o -1 */
+static int relocate(uint8_t *base, uint16_t len, uint8_t delta) {
+    uint16_t pos = 0xFFFF;
+    uint16_t fixed = 0;
+    uint8_t n = 0;
+    uint8_t i = 0;
+    uint8_t d;
+
+    while (1) {
+        if (i == n) {
+            n = (uint8_t)rom3_mfs_read(tbl, sizeof(tbl));
+            if (!n) return -1;
+            i = 0;
+        }
+        d = tbl[i++];
+        if (d == 0) return (int)fixed;
+        pos += d == 0xFF ? 254 : d;
+        if (pos >= len) return -1;
+        if (d != 0xFF) {
+            base[pos] += delta;
+            fixed++;
+        }
+    }
+}
+
+uint8_t ovl_main(const char *args) {
+    uint16_t addr;
+    uint8_t *base;
+    int fixed;
+    uint8_t i;
+
+    for (i = 0; i < 12 && *args && *args != ' '; i++) {
+        name[i] = *args++;
+    }
+    name[i] = '\0';
+    parse_hex(args, &addr);
+    if (i == 0 || (addr & 0xFF)) {
+        rom_uart_puts("Uso: RLOAD nombre [dir] (dir = inicio de pagina)\r\n");
+        return 1;
+    }
+    if (rom3_mfs_open(name) != MFS_OK) {
+        rom_uart_puts("No encontrado\r\n");
+        return 1;
+    }
+    if (rom3_mfs_read(&hdr, sizeof(hdr)) != sizeof(hdr) ||
+        hdr.magic[0] != 'X' || hdr.magic[1] != '6' || hdr.magic[2] != '5' ||
+        hdr.format != EXE_FORMAT || hdr.flags != EXE_FLAG_RELOC ||
+        (hdr.load & 0xFF) || hdr.entry - hdr.load >= hdr.len) {
+        rom_mfs_close();
+        rom_uart_puts("No es un X65 reubicable\r\n");
+        return 1;
+    }
+    if (hdr.romapi > rom_version()) {
+        rom_mfs_close();
+        rom_uart_puts("Requiere ROM API mas nueva\r\n");
+        return 1;
+    }
+    if (!addr) addr = hdr.load;
+    if (addr < RAM_START || addr >= RAM_END || hdr.len > RAM_END - addr) {
+        rom_mfs_close();
+        rom_uart_puts("No cabe en $0800-$35FF\r\n");
+        return 1;
+    }
+    if (hits_module((uint8_t)(addr >> 8),
+                    (uint8_t)((addr + hdr.len - 1) >> 8))) {
+        rom_mfs_close();
+        rom_uart_puts("Pisa un modulo residente\r\n");
+        return 1;
+    }
+
+    base = (uint8_t *)addr;
+    if (rom3_mfs_read(base, hdr.len) != hdr.len ||
+        crc32(base, hdr.len) != hdr.crc) {
+        rom_mfs_close();
+        rom_uart_puts("CRC incorrecto\r\n");
+        return 1;
+    }
+    fixed = relocate(base, hdr.len, (uint8_t)((addr - hdr.load) >> 8));
+    rom_mfs_close();
+    if (fixed < 0) {
+        rom_uart_puts("Tabla de reubicacion incorrecta\r\n");
+        return 1;
+    }
+
+    ovl_addr = hdr.entry - hdr.load + addr;
+    rom_uart_puts("Cargado en $");
+    put_hex(addr);
+    rom_uart_puts(", entrada $");
+    put_hex(ovl_addr);
+    rom_uart_puts(", corregidos ");
+    rom_u16toa((uint16_t)fixed, num);
+    rom_uart_puts(num);
+    rom_uart_puts("\r\n");
+    return 0;
+}
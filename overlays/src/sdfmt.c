@@ -0,0 +1,39 @@
+/**
+ * ============================================================================
+ * SDFMT - Overlay del monitor: formatear la SD con MicroFS
+ * ============================================================================
+ * Uso (con SDFMT.OVL en la SD):
+ *   SDFMT
+ *
+ * Pide confirmación: el formato borra todos los archivos, este overlay
+ * incluido. La ROM vacía también su índice de directorio. Una SD sin
+ * formato se ofrece a formatear sola al montarla (comando SD).
+ * ============================================================================
+ */
+
+#include <stdint.h>
+#include "../../include/romapi.h"
+
+static char hex[5];
+
+uint8_t ovl_main(const char *args) {
+    uint8_t r;
+
+    (void)args;
+    rom_uart_puts("Borra toda la SD. Seguro? (S/N): ");
+    if ((rom_uart_getc() & 0xDF) != 'S') {
+        rom_uart_puts("\r\n");
+        return 0;
+    }
+    rom_uart_puts("\r\nFormateando SD...\r\n");
+    r = rom_mfs_format();
+    if (r == MFS_OK) {
+        rom_uart_puts("OK: SD formateada\r\n");
+        return 0;
+    }
+    rom_u16tohex(r, hex);
+    rom_uart_puts("Error: ");
+    rom_uart_puts(hex + 2);
+    rom_uart_puts("\r\n");
+    return 1;
+}
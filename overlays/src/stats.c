@@ -0,0 +1,58 @@
+/**
+ * ============================================================================
+ * STATS - Overlay del monitor: contadores de errores y actividad
+ * ============================================================================
+ * Uso (con STATS.OVL en la SD):
+ *   STATS          mostrar los contadores
+ *   STATS CLR      mostrarlos y ponerlos a cero
+ *
+ * Los contadores están en el BSS de la ROM (stats_read, $BE66) y los
+ * actualizan los drivers en sus caminos de error: XMODEM (XRECV), el
+ * índice de directorio de MicroFS y los overlays DDR/DDW. Son de 16
+ * bits y dan la vuelta; se ponen a cero al arrancar.
+ * ============================================================================
+ */
+
+#include <stdint.h>
+#include "../../include/romapi.h"
+
+/* Mismo orden que rom_stats_t */
+static const char * const names[] = {
+    "XMODEM NAK     ",
+    "XMODEM timeout ",
+    "Indice aciertos",
+    "Indice fallos  ",
+    "DDR/DDW reenvio",
+};
+
+#define N_STATS     (sizeof(names) / sizeof(names[0]))
+
+static char num[6];
+
+uint8_t ovl_main(const char *args) {
+    uint16_t *c;
+    uint8_t i;
+
+    if (!rom_has_feature2(ROMAPI_FEAT2_STATS)) {
+        rom_uart_puts("ROM sin stats_read\r\n");
+        return 1;
+    }
+    c = (uint16_t *)rom_stats();
+
+    for (i = 0; i < N_STATS; i++) {
+        rom_uart_puts("  ");
+        rom_uart_puts(names[i]);
+        rom_uart_puts(" ");
+        rom_u16toa(c[i], num);
+        rom_uart_puts(num);
+        rom_uart_puts("\r\n");
+    }
+
+    while (*args == ' ') args++;
+    if ((args[0] | 0x20) == 'c' && (args[1] | 0x20) == 'l' &&
+        (args[2] | 0x20) == 'r') {
+        for (i = 0; i < N_STATS; i++) c[i] = 0;
+        rom_uart_puts("Contadores a cero\r\n");
+    }
+    return 0;
+}
@@ -0,0 +1,77 @@
+/**
+ * ============================================================================
+ * UNLZ - Overlay del monitor: cargar un archivo LZ65 descomprimido
+ * ============================================================================
+ * Uso (con UNLZ.OVL en la SD y el módulo LZ.X65 residente):
+ *   UNLZ nombre [dir]
+ *
+ * Descomprime el archivo (scripts/lzpack.py) directamente desde la SD a
+ * dir ($0800 por defecto) con $BE36 en modo archivo: sin copia
+ * comprimida en RAM. Deja dir como dirección actual del monitor, así que
+ * R sin argumento lo ejecuta. La salida no debe llegar a la ventana de
+ * overlays ($3600) ni a las páginas de los módulos.
+ * ============================================================================
+ */
+
+#include <stdint.h>
+#include "../../include/romapi.h"
+
+/* Dirección actual del monitor (cabecera, ovl_head.s) */
+extern uint16_t ovl_addr;
+
+static char name[13];
+static char num[6];
+
+static const char *parse_hex(const char *s, uint16_t *v) {
+    uint8_t c;
+
+    *v = 0;
+    while (*s == ' ') s++;
+    while (1) {
+        c = *s;
+        if (c >= '0' && c <= '9') {
+            c -= '0';
+        } else {
+            c |= 0x20;
+            if (c < 'a' || c > 'f') break;
+            c -= 'a' - 10;
+        }
+        *v = (*v << 4) | c;
+        s++;
+    }
+    return s;
+}
+
+uint8_t ovl_main(const char *args) {
+    uint16_t addr, n;
+    uint8_t i;
+
+    for (i = 0; i < 12 && *args && *args != ' '; i++) {
+        name[i] = *args++;
+    }
+    name[i] = '\0';
+    parse_hex(args, &addr);
+    if (!addr) addr = 0x0800;
+    if (i == 0) {
+        rom_uart_puts("Uso: UNLZ nombre [dir]\r\n");
+        return 1;
+    }
+    if (!((uint16_t)rom_ext_features() & ROMAPI_FEAT_LZ)) {
+        rom_uart_puts("Falta el modulo LZ.X65\r\n");
+        return 1;
+    }
+    if (rom3_mfs_open(name) != MFS_OK) {
+        rom_uart_puts("No encontrado\r\n");
+        return 1;
+    }
+
+    n = rom_lz_unpack(0, addr);
+    rom_mfs_close();
+
+    rom_uart_puts("Descomprimidos ");
+    rom_u16toa(n, num);
+    rom_uart_puts(num);
+    rom_uart_puts(" bytes\r\n");
+    ovl_addr = addr;
+    return 0;
+}
@@ -0,0 +1,165 @@
+#!/usr/bin/env python3
+"""
+Compresor LZ65 para el módulo LZ (modules/src/lz.s, ROM API $BE36)
+
+Formato (orientado a bytes):
+  $00        fin
+  0LLLLLLL   L literales (1-127) a continuación
+  1MMMMMMM   copia de M+3 bytes (3-130) desde la salida anterior:
+             0ooooooo           distancia o+1 (1-128)
+             1hhhhhhh llllllll  distancia (h:l)+1 (1-32768)
+
+Uso:
+  python lzpack.py prog.bin -o prog.lz      # comprimir
+  python lzpack.py -d prog.lz -o prog.bin   # descomprimir (verificación)
+
+En el monitor, con LZ.X65 residente: UNLZ prog.lz [dir] y R dir.
+"""
+
+import argparse
+import sys
+
+MIN_MATCH = 3
+MAX_MATCH = 130
+MAX_LIT = 127
+SHORT_DIST = 128
+MAX_DIST = 32768
+MAX_CHAIN = 256
+
+
+def match_cost(dist):
+    return 2 if dist <= SHORT_DIST else 3
+
+
+def find_matches(data):
+    """Mejor (longitud, distancia) en cada posición, por cadenas de hash"""
+    n = len(data)
+    best = [(0, 0)] * n
+    heads = {}
+    for i in range(n - MIN_MATCH + 1):
+        key = data[i:i + MIN_MATCH]
+        chain = heads.setdefault(key, [])
+        best_len, best_dist = 0, 0
+        limit = min(MAX_MATCH, n - i)
+        for j in reversed(chain[-MAX_CHAIN:]):
+            dist = i - j
+            if dist > MAX_DIST:
+                break
+            k = MIN_MATCH
+            while k < limit and data[j + k] == data[i + k]:
+                k += 1
+            # Preferir distancias cortas: ahorran un byte
+            if k > best_len or (k == best_len and match_cost(dist) < match_cost(best_dist)):
+                best_len, best_dist = k, dist
+                if k == limit:
+                    break
+        if best_len == MIN_MATCH and best_dist > SHORT_DIST:
+            best_len = 0            # 3 bytes por 3 bytes: no compensa
+        best[i] = (best_len, best_dist)
+        chain.append(i)
+    return best
+
+
+def compress(data):
+    """Parseo óptimo (programación dinámica desde el final)"""
+    data = bytes(data)
+    n = len(data)
+    matches = find_matches(data)
+    # cost[i] = bytes para codificar data[i:]; se cuenta un token de
+    # literales por cada literal que empieza una racha (aproximado)
+    cost = [0] * (n + 1)
+    step = [None] * (n + 1)
+    for i in range(n - 1, -1, -1):
+        # Literal: +1 byte, +1 token si el siguiente no es literal
+        lit = cost[i + 1] + 1 + (0 if step[i + 1] == 'L' else 1)
+        cost[i], step[i] = lit, 'L'
+        length, dist = matches[i]
+        while length >= MIN_MATCH:
+            c = cost[i + length] + match_cost(dist)
+            if c < cost[i]:
+                cost[i], step[i] = c, (length, dist)
+            length -= 1
+            if length == MIN_MATCH and dist > SHORT_DIST:
+                break
+
+    out = bytearray()
+    lits = bytearray()
+
+    def flush():
+        for k in range(0, len(lits), MAX_LIT):
+            chunk = lits[k:k + MAX_LIT]
+            out.append(len(chunk))
+            out.extend(chunk)
+        lits.clear()
+
+    i = 0
+    while i < n:
+        s = step[i]
+        if s == 'L':
+            lits.append(data[i])
+            i += 1
+            continue
+        flush()
+        length, dist = s
+        out.append(0x80 | (length - MIN_MATCH))
+        d = dist - 1
+        if dist <= SHORT_DIST:
+            out.append(d)
+        else:
+            out.append(0x80 | (d >> 8))
+            out.append(d & 0xFF)
+        i += length
+    flush()
+    out.append(0)
+    return bytes(out)
+
+
+def decompress(packed, end=False):
+    """Con end=True retorna también el offset tras el marcador de fin"""
+    out = bytearray()
+    i = 0
+    while True:
+        t = packed[i]
+        i += 1
+        if t == 0:
+            return (bytes(out), i) if end else bytes(out)
+        if t < 0x80:
+            out.extend(packed[i:i + t])
+            i += t
+            continue
+        length = (t & 0x7F) + MIN_MATCH
+        d = packed[i]
+        i += 1
+        if d & 0x80:
+            d = ((d & 0x7F) << 8) | packed[i]
+            i += 1
+        src = len(out) - d - 1
+        if src < 0:
+            raise ValueError("distancia fuera de la salida")
+        for k in range(length):     # byte a byte: admite solape
+            out.append(out[src + k])
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compresor LZ65 (modules/src/lz.s)')
+    parser.add_argument('input', help='Archivo de entrada')
+    parser.add_argument('-o', '--output', required=True, help='Archivo de salida')
+    parser.add_argument('-d', '--decompress', action='store_true', help='Descomprimir')
+    args = parser.parse_args()
+
+    data = open(args.input, 'rb').read()
+    if args.decompress:
+        result = decompress(data)
+    else:
+        result = compress(data)
+        if decompress(result) != data:
+            sys.exit("Error interno: la verificación no coincide")
+    with open(args.output, 'wb') as f:
+        f.write(result)
+    if not args.decompress:
+        pct = 100 * len(result) // max(len(data), 1)
+        print(f"{args.input}: {len(data)} -> {len(result)} bytes ({pct}%)")
+
+
+if __name__ == '__main__':
+    main()
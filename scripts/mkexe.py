@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+"""
+Cabecera de ejecutable X65 para el monitor 6502
+
+Antepone a un binario plano la cabecera de 16 bytes que entienden
+LOAD, XRECV, R, el auto-boot y la ROM API ($BF7E/$BF81):
+
+  +0  "X65"        magic
+  +3  formato      1
+  +4  ROM API      versión mínima (major<<4 | minor), 0 = cualquiera
+  +5  flags        bit 1: reubicable, tabla tras el cuerpo (RLOAD)
+  +6  load         dirección de carga (little-endian)
+  +8  entry        punto de entrada
+  +10 len          bytes de programa
+  +12 crc          CRC-32 (zlib) del programa
+
+Reubicable (--reloc): se enlaza el programa dos veces, en load y en
+load + $100 (ld65 -S), y los bytes que difieren en exactamente 1 son
+los bytes altos de dirección. El overlay RLOAD lo coloca en cualquier
+página libre y suma (página destino - página de load) a cada uno. Tabla,
+tras el cuerpo, como en o65: cada byte avanza desde la última posición
+(inicio -1) y marca un byte a corregir; $FF avanza 254 sin marcar; $00
+fin. La imagen debe incluir su BSS (lo que ocupa en RAM son len bytes).
+LOAD no acepta flags distintos de 0: se carga con RLOAD.
+
+Con --info muestra la cabecera de un archivo existente.
+"""
+
+import argparse
+import binascii
+import struct
+import sys
+
+MAGIC = b'X65'
+FORMAT = 1
+FLAG_RELOC = 0x02
+HDR = struct.Struct('<3sBBBHHHI')
+
+
+def parse_int(value):
+    """Convierte un valor de cadena a entero, aceptando tanto decimal como hexadecimal."""
+    try:
+        return int(value.replace('$', '0x'), 0)
+    except ValueError:
+        raise argparse.ArgumentTypeError(f"Valor inválido: '{value}'")
+
+
+def parse_version(value):
+    """'3.5' -> $35; también acepta el byte directo ($35, 0x35)"""
+    if '.' in value:
+        major, minor = value.split('.', 1)
+        return (int(major) << 4) | int(minor)
+    return parse_int(value)
+
+
+def reloc_table(lo, hi, load):
+    """Tabla de bytes altos a reubicar a partir de dos enlaces"""
+    if len(lo) != len(hi):
+        sys.exit("--reloc: los dos enlaces tienen distinto tamaño")
+    table = bytearray()
+    last = -1
+    for i, (a, b) in enumerate(zip(lo, hi)):
+        if a == b:
+            continue
+        if (b - a) & 0xFF != 1:
+            sys.exit(f"--reloc: ${load + i:04X} no es reubicable por páginas (${a:02X} -> ${b:02X})")
+        d = i - last
+        while d > 254:
+            table.append(0xFF)
+            d -= 254
+        table.append(d)
+        last = i
+    table.append(0)
+    return bytes(table)
+
+
+def count_fixups(table):
+    n = 0
+    for d in table:
+        if d == 0:
+            return n
+        if d != 0xFF:
+            n += 1
+    sys.exit("Tabla de reubicación sin fin")
+
+
+def show(path):
+    data = open(path, 'rb').read()
+    if len(data) < HDR.size or data[:3] != MAGIC:
+        sys.exit(f"{path}: sin cabecera X65")
+    magic, fmt, romapi, flags, load, entry, length, crc = HDR.unpack_from(data)
+    body = data[HDR.size:HDR.size + length]
+    ok = len(body) == length and binascii.crc32(body) == crc
+    print(f"formato {fmt}, ROM API >= {romapi >> 4}.{romapi & 15}, flags ${flags:02X}")
+    print(f"load ${load:04X}-${load + length - 1:04X}, entry ${entry:04X}, {length} bytes")
+    print(f"CRC-32 ${crc:08X} {'OK' if ok else 'INCORRECTO'}")
+    if flags & FLAG_RELOC:
+        print(f"reubicable: {count_fixups(data[HDR.size + length:])} bytes a corregir")
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Cabecera de ejecutable X65 para el monitor 6502')
+    parser.add_argument('input', help='Binario plano (o ejecutable con --info)')
+    parser.add_argument('-o', '--output', help='Archivo de salida (def: input con extensión .X65)')
+    parser.add_argument('-l', '--load', type=parse_int, default=0x0800, help='Dirección de carga (def $0800)')
+    parser.add_argument('-e', '--entry', type=parse_int, help='Punto de entrada (def = load)')
+    parser.add_argument('-r', '--romapi', type=parse_version, default=0,
+                        help='Versión mínima de ROM API, ej: 3.5 (def: cualquiera)')
+    parser.add_argument('--reloc', metavar='BIN_HI',
+                        help='Reubicable: el mismo programa enlazado en load + $100')
+    parser.add_argument('--info', action='store_true', help='Mostrar la cabecera de un ejecutable')
+    args = parser.parse_args()
+
+    if args.info:
+        show(args.input)
+        return
+
+    body = open(args.input, 'rb').read()
+    entry = args.load if args.entry is None else args.entry
+    if not body:
+        sys.exit("Binario vacío")
+    if args.load < 0x0800 or args.load + len(body) > 0x3E00:
+        sys.exit(f"El programa no cabe en $0800-$3DFF: ${args.load:04X} + {len(body)} bytes")
+    if not args.load <= entry < args.load + len(body):
+        sys.exit(f"Entrada ${entry:04X} fuera de la imagen (el monitor la rechaza)")
+
+    flags = 0
+    table = b''
+    if args.reloc:
+        if args.load & 0xFF:
+            sys.exit(f"--reloc: load ${args.load:04X} no es inicio de página")
+        table = reloc_table(body, open(args.reloc, 'rb').read(), args.load)
+        flags |= FLAG_RELOC
+    hdr = HDR.pack(MAGIC, FORMAT, args.romapi, flags, args.load, entry, len(body), binascii.crc32(body))
+    out = args.output or args.input.rsplit('.', 1)[0] + '.X65'
+    with open(out, 'wb') as f:
+        f.write(hdr + body + table)
+    print(f"{out}: ${args.load:04X}-${args.load + len(body) - 1:04X}, entrada ${entry:04X}, "
+          f"CRC-32 ${binascii.crc32(body):08X}")
+    if args.reloc:
+        print(f"Reubicable: {count_fixups(table)} bytes a corregir, tabla de {len(table)} bytes")
+
+
+if __name__ == '__main__':
+    main()
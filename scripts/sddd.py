@@ -0,0 +1,160 @@
+#!/usr/bin/env python3
+"""
+Imagen de sectores SD por UART (overlays DDR/DDW del monitor:
+DDR.OVL y DDW.OVL deben estar en la SD)
+Trama por sector: STX, seq, 512 bytes, CRC-16/XMODEM (hi, lo)
+"""
+
+import argparse
+import binascii
+import sys
+
+import serial
+
+STX = 0x02
+EOT = 0x04
+ACK = 0x06
+NAK = 0x15
+CAN = 0x18
+REQ = ord('C')
+SECTOR = 512
+MAX_RETRIES = 10
+
+
+def parse_int(value):
+    """Convierte un valor de cadena a entero, aceptando tanto decimal como hexadecimal."""
+    try:
+        return int(value, 0)
+    except ValueError:
+        raise argparse.ArgumentTypeError(f"Valor inválido: '{value}'. Debe ser un entero decimal o hexadecimal.")
+
+
+def read_byte(port):
+    b = port.read(1)
+    if not b:
+        raise TimeoutError("Timeout esperando respuesta de la placa")
+    return b[0]
+
+
+def send_command(port, cmd):
+    """Escribe el comando en el monitor y consume el eco y la cabecera"""
+    port.reset_input_buffer()
+    port.write(cmd.encode('ascii') + b'\r')
+    tag = cmd[:3].encode('ascii')
+    # Eco de la línea y luego la cabecera "DDx sector $.... n=..."
+    seen = 0
+    while seen < 2:
+        line = port.readline()
+        if not line:
+            raise TimeoutError("El monitor no respondió al comando")
+        if tag in line.upper():
+            seen += 1
+
+
+def progress(done, total):
+    sys.stdout.write(f"\r  {done}/{total} sectores")
+    sys.stdout.flush()
+
+
+def dd_read(port, start, count, path):
+    """SD -> imagen (DDR)"""
+    send_command(port, f"DDR {start:X} {count:X}")
+    port.write(bytes([REQ]))
+
+    with open(path, 'wb') as out:
+        expected = 0
+        while True:
+            head = read_byte(port)
+            if head == EOT:
+                port.write(bytes([ACK]))
+                break
+            if head == CAN:
+                raise RuntimeError("La placa canceló (error SD)")
+            if head != STX:
+                continue
+            frame = port.read(1 + SECTOR + 2)
+            if len(frame) != 1 + SECTOR + 2:
+                port.write(bytes([NAK]))
+                continue
+            seq, data = frame[0], frame[1:1 + SECTOR]
+            crc = (frame[-2] << 8) | frame[-1]
+            if binascii.crc_hqx(data, 0) != crc:
+                port.write(bytes([NAK]))
+                continue
+            if seq == (expected & 0xFF):
+                out.write(data)
+                expected += 1
+                progress(expected, count)
+            port.write(bytes([ACK]))
+    print()
+    return expected
+
+
+def dd_write(port, start, path):
+    """Imagen -> SD (DDW). La imagen se rellena a múltiplo de 512"""
+    with open(path, 'rb') as f:
+        image = f.read()
+    if len(image) % SECTOR:
+        image += b'\x00' * (SECTOR - len(image) % SECTOR)
+    count = len(image) // SECTOR
+    if not 0 < count <= 0xFFFF:
+        raise ValueError("La imagen debe tener entre 1 y 65535 sectores")
+
+    send_command(port, f"DDW {start:X} {count:X}")
+    while read_byte(port) != REQ:
+        pass
+
+    for i in range(count):
+        data = image[i * SECTOR:(i + 1) * SECTOR]
+        crc = binascii.crc_hqx(data, 0)
+        frame = bytes([STX, i & 0xFF]) + data + bytes([crc >> 8, crc & 0xFF])
+        for _ in range(MAX_RETRIES):
+            port.write(frame)
+            reply = read_byte(port)
+            while reply == REQ:             # 'C' retrasadas del arranque
+                reply = read_byte(port)
+            if reply == ACK:
+                break
+            if reply == CAN:
+                raise RuntimeError("La placa canceló (error SD)")
+        else:
+            port.write(bytes([CAN]))
+            raise RuntimeError(f"Demasiados reintentos en sector {i}")
+        progress(i + 1, count)
+
+    port.write(bytes([EOT]))
+    read_byte(port)
+    print()
+    return count
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(
+        description='Volcado/restauración de sectores SD por UART (DDR/DDW)',
+        formatter_class=argparse.ArgumentDefaultsHelpFormatter)
+
+    parser.add_argument('mode', choices=['read', 'write'], help='read: SD -> imagen, write: imagen -> SD')
+    parser.add_argument('port', help='Puerto serie (ej: COM3, /dev/ttyUSB0)')
+    parser.add_argument('image', help='Archivo de imagen')
+    parser.add_argument('-s', '--start', type=parse_int, default=0, help='Primer sector')
+    parser.add_argument('-n', '--count', type=parse_int, help='Sectores a leer (solo read)')
+    parser.add_argument('-b', '--baud', type=int, default=115200, help='Baudrate')
+    parser.add_argument('-t', '--timeout', type=float, default=5.0, help='Timeout en segundos')
+
+    args = parser.parse_args()
+
+    if args.mode == 'read' and not args.count:
+        parser.error("read requiere -n/--count")
+    if args.count is not None and not 0 < args.count <= 0xFFFF:
+        parser.error("count debe estar entre 1 y 65535")
+
+    try:
+        with serial.Serial(args.port, args.baud, timeout=args.timeout) as port:
+            if args.mode == 'read':
+                n = dd_read(port, args.start, args.count, args.image)
+            else:
+                n = dd_write(port, args.start, args.image)
+        print(f"OK: {n} sectores ({n * SECTOR} bytes)")
+    except Exception as e:
+        print(f"❌ Error: {e}")
+        exit(1)
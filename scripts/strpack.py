@@ -0,0 +1,226 @@
+#!/usr/bin/env python3
+"""
+Compresor de textos del monitor (diccionario de tokens)
+
+Lee libs/monitor/mon_text.txt y genera:
+  <salida>.s  datos para src/msgdec.s (diccionario + mensajes)
+  <salida>.h  #define MSG_xxx con el número de cada mensaje
+
+Formato del flujo (un mensaje tras otro, terminados en $00):
+  $01-$7F  carácter literal ($0A = "\\r\\n")
+  $80-$FF  token: entrada (byte & $7F) del diccionario
+
+El diccionario son cadenas ASCII con el bit 7 puesto en el último
+carácter, indexadas por una tabla de offsets de 1 byte (máximo 256
+bytes de diccionario).
+"""
+
+import argparse
+import os
+import re
+import sys
+from collections import Counter
+
+MAX_TOKENS = 128
+MAX_DICT = 256
+MAX_TOKEN_LEN = 16
+TOKEN_BASE = 0x100      # símbolos internos para tokens (fuera de 0-255)
+
+LINE_RE = re.compile(r'^(MSG_[A-Z0-9_]+)\s+(".*")\s*$')
+CONT_RE = re.compile(r'^\s+(".*")\s*$')
+STR_RE = re.compile(r'"((?:[^"\\]|\\.)*)"')
+
+
+def unescape(lit, path, lineno):
+    """Literal C -> bytes. \\r\\n se codifica como $0A"""
+    out = []
+    body = ''.join(STR_RE.findall(lit))
+    i = 0
+    while i < len(body):
+        c = body[i]
+        if c == '\\':
+            pair = body[i:i + 4]
+            if pair == '\\r\\n':
+                out.append(0x0A)
+                i += 4
+                continue
+            nxt = body[i + 1:i + 2]
+            if nxt in ('"', '\\'):
+                out.append(ord(nxt))
+                i += 2
+                continue
+            sys.exit(f"{path}:{lineno}: escape no soportado '\\{nxt}' (solo \\r\\n, \\\", \\\\)")
+        if not 0x20 <= ord(c) < 0x7F:
+            sys.exit(f"{path}:{lineno}: carácter no ASCII {c!r}")
+        out.append(ord(c))
+        i += 1
+    return out
+
+
+def parse(path):
+    msgs = []
+    with open(path, encoding='utf-8') as f:
+        for lineno, line in enumerate(f, 1):
+            line = line.rstrip('\n')
+            if not line.strip() or line.lstrip().startswith('#'):
+                continue
+            m = LINE_RE.match(line)
+            if m:
+                if any(name == m.group(1) for name, _ in msgs):
+                    sys.exit(f"{path}:{lineno}: mensaje duplicado {m.group(1)}")
+                msgs.append((m.group(1), unescape(m.group(2), path, lineno)))
+                continue
+            m = CONT_RE.match(line)
+            if m and msgs:
+                msgs[-1][1].extend(unescape(m.group(1), path, lineno))
+                continue
+            sys.exit(f"{path}:{lineno}: línea no válida")
+    if not msgs:
+        sys.exit(f"{path}: sin mensajes")
+    if len(msgs) > 255:
+        sys.exit(f"{path}: máximo 255 mensajes")
+    for name, data in msgs:
+        if not data:
+            sys.exit(f"{path}: mensaje vacío {name}")
+    return msgs
+
+
+def count(seqs, pat):
+    """Apariciones sin solapar de pat en todas las secuencias"""
+    pat = list(pat)
+    n = 0
+    k = len(pat)
+    for s in seqs:
+        i = 0
+        while i <= len(s) - k:
+            if s[i:i + k] == pat:
+                n += 1
+                i += k
+            else:
+                i += 1
+    return n
+
+
+def replace(seq, pat, sym):
+    out = []
+    k = len(pat)
+    i = 0
+    while i < len(seq):
+        if seq[i:i + k] == pat:
+            out.append(sym)
+            i += k
+        else:
+            out.append(seq[i])
+            i += 1
+    return out
+
+
+def build_dict(seqs):
+    """Diccionario voraz: en cada paso el patrón que más bytes ahorra"""
+    words = []
+    dict_size = 0
+    while len(words) < MAX_TOKENS:
+        # Conteo aproximado (con solapes) para preseleccionar candidatos
+        cand = Counter()
+        for s in seqs:
+            for i in range(len(s)):
+                if s[i] >= TOKEN_BASE:
+                    continue
+                for k in range(2, MAX_TOKEN_LEN + 1):
+                    pat = tuple(s[i:i + k])
+                    if len(pat) < k or pat[-1] >= TOKEN_BASE:
+                        break
+                    cand[pat] += 1
+        ranked = sorted((pat for pat in cand if dict_size + len(pat) <= MAX_DICT),
+                        key=lambda p: (-(cand[p] * (len(p) - 1) - len(p)), p))
+        best, best_gain = None, 0
+        for pat in ranked[:64]:
+            # Cada uso ahorra len-1; la entrada cuesta len + 1 (offset)
+            gain = count(seqs, pat) * (len(pat) - 1) - len(pat) - 1
+            if gain > best_gain or (gain == best_gain and best and pat < best):
+                best, best_gain = pat, gain
+        if not best:
+            break
+        sym = TOKEN_BASE + len(words)
+        seqs = [replace(s, list(best), sym) for s in seqs]
+        words.append(best)
+        dict_size += len(best)
+    return words, seqs
+
+
+def asm_bytes(data, indent='        '):
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append(indent + '.byte ' + ','.join(f'${b:02X}' for b in data[i:i + 16]))
+    return lines
+
+
+def printable(data):
+    return ''.join('\\r\\n' if b == 0x0A else chr(b) for b in data)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compresor de textos del monitor')
+    parser.add_argument('input', help='Fuente de mensajes (mon_text.txt)')
+    parser.add_argument('-o', '--output', required=True, help='Base de salida (genera .s y .h)')
+    args = parser.parse_args()
+
+    msgs = parse(args.input)
+    seqs = [list(data) for _, data in msgs]
+    words, packed = build_dict(seqs)
+
+    # Bytes literales < $80; tokens $80 + índice
+    stream = [[b if b < TOKEN_BASE else 0x80 + b - TOKEN_BASE for b in s] for s in packed]
+    dict_bytes = []
+    offsets = []
+    for w in words:
+        offsets.append(len(dict_bytes))
+        dict_bytes.extend(w[:-1])
+        dict_bytes.append(w[-1] | 0x80)
+
+    src = os.path.basename(args.input)
+    out = [
+        ';; ===========================================================================',
+        f';; {os.path.basename(args.output).upper()}.S - Generado por scripts/strpack.py desde {src}',
+        ';; NO EDITAR: modificar el .txt y recompilar',
+        ';; ===========================================================================',
+        '',
+        '.export msg_dict_ofs, msg_dict, msg_text',
+        '',
+        '.segment "RODATA"',
+        '',
+        'msg_dict_ofs:',
+    ]
+    out += asm_bytes(offsets) if offsets else ['        ; (vacío)']
+    out += ['', 'msg_dict:']
+    out += asm_bytes(dict_bytes) if dict_bytes else ['        ; (vacío)']
+    out += ['', 'msg_text:']
+    for (name, data), s in zip(msgs, stream):
+        out.append(f'; {name}: "{printable(data)[:60]}"')
+        out += asm_bytes(s + [0])
+    with open(args.output + '.s', 'w', encoding='utf-8', newline='\n') as f:
+        f.write('\n'.join(out) + '\n')
+
+    guard = os.path.basename(args.output).upper() + '_H'
+    hdr = [
+        f'/* {os.path.basename(args.output)}.h - Generado por scripts/strpack.py desde {src}',
+        ' * NO EDITAR: modificar el .txt y recompilar */',
+        '',
+        f'#ifndef {guard}',
+        f'#define {guard}',
+        '',
+    ]
+    width = max(len(name) for name, _ in msgs)
+    hdr += [f'#define {name:<{width}} {i}' for i, (name, _) in enumerate(msgs)]
+    hdr += ['', f'#endif /* {guard} */']
+    with open(args.output + '.h', 'w', encoding='utf-8', newline='\n') as f:
+        f.write('\n'.join(hdr) + '\n')
+
+    raw = sum(len(d) + 1 for _, d in msgs)
+    packed_size = sum(len(s) + 1 for s in stream) + len(dict_bytes) + len(offsets)
+    print(f"strpack: {len(msgs)} mensajes, {raw} -> {packed_size} bytes "
+          f"({len(words)} tokens, diccionario {len(dict_bytes)} bytes)")
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,21 @@
+// fastmath.h - Formato de números en ROM (fastmath.s)
+// Las funciones fmt_* retornan un buffer estático que se reutiliza en
+// cada llamada: imprimirlo o copiarlo antes de la siguiente
+
+#ifndef FASTMATH_H
+#define FASTMATH_H
+
+#include <stdint.h>
+
+// Function: fmt_u32
+// Convierte a decimal (BCD con modo decimal, sin dividir)
+// Returns:
+//   Cadena terminada en NUL, sin ceros a la izquierda
+const char *fmt_u32(uint32_t val);
+
+// Function: fmt_hex16
+// Returns:
+//   Cadena de 4 dígitos hex en mayúsculas ("0000".."FFFF")
+const char *fmt_hex16(uint16_t val);
+
+#endif // FASTMATH_H
@@ -0,0 +1,210 @@
+;; ===========================================================================
+;; FASTMATH.S - Formato de números en ROM
+;; ===========================================================================
+;;
+;; Sustituye a la división genérica de CC65 (% 10, / 10) en los
+;; printers del monitor y se publica en el bloque v3 de la ROM API.
+;; La conversión a decimal usa BCD con ADC en modo decimal (doble y
+;; suma por bit), sin divisiones. Multiplicación y división de la
+;; ROM API ($BE1E-$BE24) las sirve el módulo modules/src/muldiv.s.
+;;
+;; Entradas ROM API (ZP fijo):
+;;   bin_to_bcd  $F0-$F3 -> 5 bytes BCD (little-endian) en ($F4)
+;;   u16toa      $F0-$F1 -> cadena decimal en ($F4), A = longitud
+;;   u32toa      $F0-$F3 -> cadena decimal en ($F4), A = longitud
+;;   u16tohex    $F0-$F1 -> "HHHH" en ($F4), A = 4
+;;
+;; Para C (monitor), fastcall con buffer estático:
+;;   const char *fmt_u32(uint32_t val);
+;;   const char *fmt_hex16(uint16_t val);
+;;
+;; Las IRQ/NMI de la ROM solo hacen RTI, así que el modo decimal
+;; no necesita SEI.
+;; ===========================================================================
+
+.export _bin_to_bcd
+.export _u16toa
+.export _u32toa
+.export _u16tohex
+.export _fmt_u32
+.export _fmt_hex16
+
+.importzp sreg
+
+.segment "BSS"
+m_val:  .res 4                  ; valor binario (se desplaza)
+m_bcd:  .res 5                  ; 10 dígitos BCD, little-endian
+m_str:  .res 11                 ; cadena de salida + NUL
+
+.segment "CODE"
+
+; ---------------------------------------------------------------------------
+; cvt_bcd - m_val (alineado arriba) -> m_bcd. X = número de bits
+; ---------------------------------------------------------------------------
+cvt_bcd:
+    lda     #0
+    ldy     #4
+:   sta     m_bcd,y
+    dey
+    bpl     :-
+    sed
+@loop:
+    asl     m_val
+    rol     m_val+1
+    rol     m_val+2
+    rol     m_val+3         ; C = bit más alto
+    ldy     #$FB            ; Y = -5..-1 sobre m_bcd+5: INY no toca C
+@add:                       ; bcd = bcd * 2 + C (en decimal)
+    lda     m_bcd+5-256,y
+    adc     m_bcd+5-256,y
+    sta     m_bcd+5-256,y
+    iny
+    bne     @add
+    dex
+    bne     @loop
+    cld
+    rts
+
+; ---------------------------------------------------------------------------
+; bcd_to_str - m_bcd -> m_str sin ceros a la izquierda. Y = longitud
+; ---------------------------------------------------------------------------
+bcd_to_str:
+    ldy     #0
+    ldx     #4
+@byte:
+    lda     m_bcd,x
+    lsr     a
+    lsr     a
+    lsr     a
+    lsr     a
+    jsr     put_digit
+    lda     m_bcd,x
+    and     #$0F
+    jsr     put_digit
+    dex
+    bpl     @byte
+    cpy     #0
+    bne     @end
+    lda     #'0'            ; valor 0
+    sta     m_str
+    iny
+@end:
+    lda     #0
+    sta     m_str,y
+    rts
+
+; A = dígito (Z según A). Omite ceros mientras no haya salida
+put_digit:
+    bne     :+
+    cpy     #0
+    beq     @skip
+:   ora     #'0'
+    sta     m_str,y
+    iny
+@skip:
+    rts
+
+; m_str -> ($F4), con NUL. Retorna A = longitud
+copy_out:
+    ldy     #0
+:   lda     m_str,y
+    sta     ($F4),y
+    beq     :+
+    iny
+    bne     :-
+:   tya
+    ldx     #0
+    rts
+
+; ---------------------------------------------------------------------------
+; Entradas ROM API
+; ---------------------------------------------------------------------------
+load_val32:
+    ldx     #3
+:   lda     $F0,x
+    sta     m_val,x
+    dex
+    bpl     :-
+    ldx     #32
+    jmp     cvt_bcd
+
+_bin_to_bcd:
+    jsr     load_val32
+    ldy     #4
+:   lda     m_bcd,y
+    sta     ($F4),y
+    dey
+    bpl     :-
+    rts
+
+_u32toa:
+    jsr     load_val32
+    jsr     bcd_to_str
+    jmp     copy_out
+
+_u16toa:
+    lda     #0
+    sta     m_val
+    sta     m_val+1
+    lda     $F0
+    sta     m_val+2
+    lda     $F1
+    sta     m_val+3
+    ldx     #16
+    jsr     cvt_bcd
+    jsr     bcd_to_str
+    jmp     copy_out
+
+_u16tohex:
+    lda     $F0
+    ldx     $F1
+    jsr     _fmt_hex16
+    jmp     copy_out
+
+; ---------------------------------------------------------------------------
+; Entradas C (fastcall): retornan puntero a m_str
+; ---------------------------------------------------------------------------
+_fmt_u32:
+    sta     m_val
+    stx     m_val+1
+    lda     sreg
+    sta     m_val+2
+    lda     sreg+1
+    sta     m_val+3
+    ldx     #32
+    jsr     cvt_bcd
+    jsr     bcd_to_str
+    lda     #<m_str
+    ldx     #>m_str
+    rts
+
+_fmt_hex16:
+    pha
+    txa
+    ldy     #0
+    jsr     hex_byte
+    pla
+    jsr     hex_byte
+    lda     #0
+    sta     m_str,y
+    lda     #<m_str
+    ldx     #>m_str
+    rts
+
+hex_byte:
+    pha
+    lsr     a
+    lsr     a
+    lsr     a
+    lsr     a
+    jsr     hex_nib
+    pla
+    and     #$0F
+hex_nib:
+    cmp     #10
+    bcc     :+
+    adc     #6              ; C = 1: +7 -> 'A'..'F'
+:   adc     #'0'
+    sta     m_str,y
+    iny
+    rts
@@ -0,0 +1,21 @@
+// mem_ops.h - CRC de memoria en ROM (mem_ops.s)
+
+#ifndef MEM_OPS_H
+#define MEM_OPS_H
+
+#include <stdint.h>
+
+// Function: mem_crc32
+// CRC-32 de zlib (el de binascii.crc32 en Python) de len bytes desde p
+// Returns:
+//   CRC final (ya invertido)
+uint32_t mem_crc32(const void *p, uint16_t len);
+
+// Function: mem_crc16
+// CRC-16/CCITT (inicial $FFFF, el de binascii.crc_hqx(data, 0xFFFF))
+// de len bytes desde p. Unas 4,7 veces más rápido que mem_crc32
+// Returns:
+//   CRC
+uint16_t mem_crc16(const void *p, uint16_t len);
+
+#endif // MEM_OPS_H
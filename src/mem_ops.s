@@ -0,0 +1,170 @@
+;; ===========================================================================
+;; MEM_OPS.S - CRC de bloques de memoria
+;; ===========================================================================
+;;
+;; Para C (monitor):
+;;   uint32_t mem_crc32(const void *p, uint16_t len);
+;;               CRC-32 de zlib (reflejado, $EDB88320), bit a bit y
+;;               sin tabla: ~360 ciclos/byte. Para las cabeceras de
+;;               ejecutable
+;;   uint16_t mem_crc16(const void *p, uint16_t len);
+;;               CRC-16/CCITT ($1021, inicial $FFFF), un byte por vuelta
+;;               y sin tabla: 76-77 ciclos/byte. Para el reset en
+;;               caliente, donde el CRC-32 tardaría 1,5 s con 13,5 KB
+;;
+;; ===========================================================================
+
+.export _mem_crc32
+.export _mem_crc16
+
+.import popax
+
+.importzp ptr1, ptr2, tmp1, tmp2, tmp3, sreg
+
+.segment "CODE"
+
+; ---------------------------------------------------------------------------
+; _mem_crc32 - fastcall: len en A/X, puntero en el stack de CC65
+; CRC en tmp1 (bajo), tmp2, ptr2, ptr2+1 (alto); sreg cuenta bytes.
+; Durante los 8 bits el byte bajo vive en A
+; ---------------------------------------------------------------------------
+_mem_crc32:
+    sta     sreg
+    stx     sreg+1
+    jsr     popax
+    sta     ptr1
+    stx     ptr1+1
+    lda     #$FF
+    sta     tmp1
+    sta     tmp2
+    sta     ptr2
+    sta     ptr2+1
+    lda     sreg
+    ora     sreg+1
+    beq     cr_done
+cr_byte:
+    ldy     #0
+    lda     (ptr1),y
+    eor     tmp1
+    ldy     #8
+cr_bit:
+    lsr     ptr2+1
+    ror     ptr2
+    ror     tmp2
+    ror     a
+    bcc     cr_next
+    tax
+    lda     ptr2+1
+    eor     #$ED
+    sta     ptr2+1
+    lda     ptr2
+    eor     #$B8
+    sta     ptr2
+    lda     tmp2
+    eor     #$83
+    sta     tmp2
+    txa
+    eor     #$20
+cr_next:
+    dey
+    bne     cr_bit
+    sta     tmp1
+    inc     ptr1
+    bne     :+
+    inc     ptr1+1
+:   lda     sreg
+    bne     :+
+    dec     sreg+1
+:   dec     sreg
+    lda     sreg
+    ora     sreg+1
+    bne     cr_byte
+cr_done:
+    lda     ptr2            ; resultado = ~crc en sreg:A:X
+    eor     #$FF
+    sta     sreg
+    lda     ptr2+1
+    eor     #$FF
+    sta     sreg+1
+    lda     tmp2
+    eor     #$FF
+    tax
+    lda     tmp1
+    eor     #$FF
+    rts
+
+; ---------------------------------------------------------------------------
+; _mem_crc16 - fastcall: len en A/X, puntero en el stack de CC65
+; CRC en tmp1 (bajo) y tmp2 (alto); ptr2+1 cuenta páginas.
+; El resto (len & $FF) va primero: ptr1 retrocede 256-n bytes e Y
+; empieza en 256-n, así el bucle de página también lo recorre.
+; Las 8 iteraciones del polinomio se resuelven con desplazamientos del
+; byte (x^12 y x^5), sin bucle de bits.
+; Ciclos por byte: 5 (lda) + 66 (CRC) + 5 (iny/bne) = 76, +1 al
+; cruzar página
+; ---------------------------------------------------------------------------
+_mem_crc16:
+    sta     ptr2
+    stx     ptr2+1
+    jsr     popax
+    sta     ptr1
+    stx     ptr1+1
+    lda     #$FF
+    sta     tmp1
+    sta     tmp2
+    ldy     #0
+    lda     ptr2
+    beq     c16_pages
+    sec                     ; Y = 256 - n, ptr1 -= 256 - n
+    lda     #0
+    sbc     ptr2
+    tay
+    sty     tmp3
+    sec
+    lda     ptr1
+    sbc     tmp3
+    sta     ptr1
+    bcs     :+
+    dec     ptr1+1
+:   inc     ptr2+1          ; el resto cuenta como una página más
+c16_pages:
+    lda     ptr2+1
+    beq     c16_done
+c16_byte:
+    lda     (ptr1),y
+    eor     tmp2
+    sta     tmp2
+    lsr     a
+    lsr     a
+    lsr     a
+    lsr     a
+    tax                     ; término x^12 (alto)
+    asl     a
+    eor     tmp1            ; término x^5 (alto)
+    sta     tmp1
+    txa
+    eor     tmp2
+    sta     tmp2
+    asl     a
+    asl     a
+    asl     a
+    tax                     ; término x^12 (bajo)
+    asl     a
+    asl     a
+    eor     tmp2            ; término x^5 (bajo): nuevo byte bajo
+    sta     tmp3
+    txa
+    rol     a
+    eor     tmp1            ; nuevo byte alto
+    sta     tmp2
+    lda     tmp3
+    sta     tmp1
+    iny
+    bne     c16_byte
+    inc     ptr1+1
+    dec     ptr2+1
+    bne     c16_byte
+c16_done:
+    lda     tmp1
+    ldx     tmp2
+    rts
@@ -0,0 +1,15 @@
+// msgdec.h - Textos comprimidos del monitor (msgdec.s)
+// Los MSG_xxx están en mon_text.h, generado por scripts/strpack.py
+// desde libs/monitor/mon_text.txt
+
+#ifndef MSGDEC_H
+#define MSGDEC_H
+
+#include <stdint.h>
+#include "mon_text.h"
+
+// Function: mon_msg
+// Descomprime el mensaje id directo a la UART ($0A sale como CR LF)
+void mon_msg(uint8_t id);
+
+#endif // MSGDEC_H
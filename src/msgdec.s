@@ -0,0 +1,97 @@
+;; ===========================================================================
+;; MSGDEC.S - Decodificador de textos comprimidos del monitor
+;; ===========================================================================
+;;
+;; Los textos viven en libs/monitor/mon_text.txt; scripts/strpack.py
+;; los codifica con un diccionario de tokens en build/mon_text.s:
+;;
+;;   msg_text      mensajes seguidos, cada uno terminado en $00
+;;                 $01-$7F literal ($0A se imprime como CR LF)
+;;                 $80-$FF token (índice & $7F en el diccionario)
+;;   msg_dict      entradas ASCII, bit 7 en el último carácter
+;;   msg_dict_ofs  offset de cada entrada (diccionario <= 256 bytes)
+;;
+;; El texto va directo a la UART, sin buffer en RAM. Para llegar al
+;; mensaje N se recorren los N anteriores: con ~2 KB de texto son
+;; unos pocos ms, despreciable frente a imprimirlo a 115200.
+;;
+;; void __fastcall__ mon_msg(uint8_t id);
+;; ===========================================================================
+
+.export _mon_msg
+
+.import _uart_putc
+.import msg_dict_ofs, msg_dict, msg_text
+.importzp ptr4
+
+.segment "BSS"
+dict_x: .res 1                  ; posición en msg_dict (uart_putc usa X;
+                                ; ptr4 no lo toca)
+
+.segment "CODE"
+
+; ---------------------------------------------------------------------------
+; _mon_msg - A = número de mensaje (MSG_xxx de mon_text.h)
+; ---------------------------------------------------------------------------
+_mon_msg:
+    tax
+    lda     #<msg_text
+    sta     ptr4
+    lda     #>msg_text
+    sta     ptr4+1
+    ldy     #0
+    txa
+    beq     @print
+
+    ; Saltar X mensajes
+@skip:
+    lda     (ptr4),y
+    inc     ptr4
+    bne     :+
+    inc     ptr4+1
+:   cmp     #0
+    bne     @skip
+    dex
+    bne     @skip
+
+@print:
+    ldy     #0
+    lda     (ptr4),y
+    beq     @done
+    tax
+    inc     ptr4
+    bne     :+
+    inc     ptr4+1
+:   txa                         ; N = token
+    bmi     @token
+    jsr     put_char
+    jmp     @print
+
+@token:
+    and     #$7F
+    tax
+    lda     msg_dict_ofs,x
+    tax
+@tok_loop:
+    stx     dict_x
+    lda     msg_dict,x
+    pha
+    and     #$7F
+    jsr     put_char
+    pla
+    bmi     @print              ; bit 7: fin de la entrada
+    ldx     dict_x
+    inx
+    bne     @tok_loop           ; siempre (diccionario <= 256 bytes)
+
+@done:
+    rts
+
+; A = carácter; $0A sale como CR LF
+put_char:
+    cmp     #$0A
+    bne     :+
+    lda     #$0D
+    jsr     _uart_putc
+    lda     #$0A
+:   jmp     _uart_putc
@@ -15,23 +15,32 @@
 ;;   JSR $BF03   ; mfs_mount
 ;;   etc.
 ;;
+;; v3 ($BE00): bloque aparte donde TODAS las entradas toman punteros y
+;; longitudes de ZP $F0-$F7 (y A), nunca del stack de CC65 del que
+;; llama. Varias pasan por funciones C de la ROM, que por dentro usan
+;; el stack de CC65 del monitor (sp en $0E). Las direcciones v2.x de
+;; $BF00 siguen igual.
+;;
+;; Los servicios que no caben en la ROM saltan por un vector en RAM
+;; (ranuras de extensión, ver más abajo): los atiende un módulo
+;; residente de modules/ y, mientras no haya ninguno, retornan $FF.
+;;
 ;; ===========================================================================
 
 .export _romapi_start
+.export _mon_ext_vec
+.export _mon_ext_reset
+.export _mon_ext_drop
+.export _mon_idle
+.export _mon_stats
 
 ; Importar funciones de las librerías
 .import _sd_init
-.import _mfs_mount
-.import _mfs_open
 .import _mfs_read
 .import _mfs_read_ext
-.import _mfs_close
 .import _mfs_get_size
 .import _mfs_list
-.import _mfs_create
 .import _mfs_write
-.import _mfs_delete
-.import _mfs_format
 .import _uart_init
 .import _uart_putc
 .import _uart_getc
@@ -54,6 +63,12 @@
 .import _spi_receive
 .import _spi_busy
 
+; Importar aritmética y formato (fastmath.s)
+.import _bin_to_bcd
+.import _u16toa
+.import _u32toa
+.import _u16tohex
+
 ; Importar funciones I2C
 .import _i2c_init
 .import _i2c_start
@@ -72,16 +87,63 @@
 ; Importar funciones de carga/ejecución del monitor
 .import _mon_sd_load
 .import _mon_execute
+.import _mon_cmd_register
+
+; Importar MicroFS con índice de directorio del monitor
+.import _mon_fs_mount
+.import _mon_fs_format
+.import _mon_fs_create
+.import _mon_fs_delete
+.import _mon_fs_open
+.import _mon_fs_close
+.import _mon_fs_list_zp
+.import _mon_fs_get_size32
 
 ; Importar runtime de CC65 para manipular stack
 .import pushax
 .import pusha
-.importzp ptr1, ptr2, tmp1
-
-; Buffer temporal para mfs_list_wrap
-.export _mfs_list_tmp
-_mfs_list_tmp:
-    .res    16
+.import popa
+.importzp ptr1, ptr2, tmp1, tmp2, sreg
+
+; Bitmap de funciones disponibles ($BF8B-$BF8C). Solo lo que sirve la
+; ROM; los bits "módulo" los suma ext_features ($BE6C) cuando un módulo
+; residente atiende esas ranuras
+ROMAPI_FEAT_SEEK    = $0002     ; módulo: $BF96/$BF99/$BE09 seek/tell del stream
+ROMAPI_FEAT_SPIBLK  = $0004     ; módulo: $BF9C/$BE12 spi_transfer_block, $BE5D
+ROMAPI_FEAT_STREAM  = $0008     ; módulo: $BF9F-$BFA8 streaming
+ROMAPI_FEAT_V3      = $0010     ; bloque v3 en $BE00 (parámetros en ZP)
+ROMAPI_FEAT_MEM     = $0020     ; módulo: $BE15-$BE1B mem_copy/fill/compare
+ROMAPI_FEAT_MATH    = $0040     ; $BE27-$BE30 BCD/formato decimal y hex
+ROMAPI_FEAT_RUNTIME = $0080     ; $BD00 runtime CC65 (include/romrt.s)
+ROMAPI_FEAT_CMDREG  = $0100     ; $BE33 cmd_register
+ROMAPI_FEAT_EXEHDR  = $0200     ; $BF7E/$BF81 entienden la cabecera X65
+ROMAPI_FEAT_LZ      = $0400     ; módulo: $BE36 lz_unpack
+ROMAPI_FEAT_ALLOC   = $1000     ; módulo: $BE39-$BE4B arena y pools
+ROMAPI_FEAT_SCHED   = $2000     ; módulo: $BE4E-$BE54 tareas
+ROMAPI_FEAT_ALARM   = $4000     ; módulo: $BE57-$BE5A alarmas
+ROMAPI_FEAT_BUSBLK  = $8000     ; módulo: $BE60-$BE63 I2C en bloque
+; $0001 y $0800 sin asignar
+; Segundo bitmap ($BF8D), desde v3.12: el de 16 bits está completo
+ROMAPI_FEAT2_STATS  = $01       ; $BE66 stats_read
+ROMAPI_FEAT2_EXT    = $02       ; ranuras de extensión, $BE69/$BE6C (v3.13)
+ROMAPI_FEAT2_MULDIV = $04       ; módulo: $BE1E-$BE24 mul8x8/mul16x16/div32x16
+ROMAPI_FEATURES2    = ROMAPI_FEAT2_EXT | ROMAPI_FEAT2_STATS
+
+ROMAPI_FEATURES     = ROMAPI_FEAT_V3 | ROMAPI_FEAT_MATH | ROMAPI_FEAT_RUNTIME | ROMAPI_FEAT_CMDREG | ROMAPI_FEAT_EXEHDR
+
+; Ranuras de extensión: índice en _mon_ext_vec (mismo orden que
+; ROMAPI_X_* en include/romapi.h). Un módulo registra un tramo
+; consecutivo
+X_SPIBLK    = 0                 ; spi_transfer_block
+X_BUSBLK    = 1                 ; spi_xfer_buf, i2c_write_buf, i2c_read_buf
+X_STREAM    = 4                 ; stream open/getc/poll/close, seek, tell
+X_MEM       = 10                ; mem_copy, mem_fill, mem_compare
+X_MULDIV    = 13                ; mul8x8, mul16x16, div32x16
+X_LZ        = 16                ; lz_unpack
+X_ALLOC     = 17                ; arena_init/alloc/mark/release, pool_init/alloc/free
+X_TASK      = 24                ; task_add, task_remove, task_yield
+X_ALARM     = 27                ; alarm_set, alarm_cancel
+X_COUNT     = 29
 
 ; ===========================================================================
 ; SEGMENTO ROMAPI - Posición fija en $BF00
@@ -100,9 +162,9 @@ sd_init_entry:
 ; ---------------------------------------------------------------------------
 ; FUNCIONES MICROFS (Base: $BF03)
 ; ---------------------------------------------------------------------------
-; $BF03 - mfs_mount
+; $BF03 - mfs_mount (monta y carga el índice de directorio en RAM)
 mfs_mount_entry:
-    JMP _mfs_mount
+    JMP _mon_fs_mount
 
 ; $BF06 - mfs_open (param: puntero a nombre en AX)
 ; Wrapper: name en $F4-$F5 (ZP)
@@ -116,7 +178,7 @@ mfs_read_entry:
 
 ; $BF0C - mfs_close
 mfs_close_entry:
-    JMP _mfs_close
+    JMP _mon_fs_close
 
 ; $BF0F - mfs_get_size
 mfs_get_size_entry:
@@ -216,9 +278,9 @@ mfs_write_entry:
 mfs_delete_entry:
     JMP mfs_delete_wrap
 
-; $BF45 - mfs_format
+; $BF45 - mfs_format (vacía también el índice)
 mfs_format_entry:
-    JMP _mfs_format
+    JMP _mon_fs_format
 
 ; ---------------------------------------------------------------------------
 ; FUNCIONES SPI (Base: $BF48)
@@ -285,15 +347,13 @@ i2c_read_entry:
 ; ---------------------------------------------------------------------------
 ; FUNCIONES SD CARD - Acceso a sectores (Base: $BF72)
 ; ---------------------------------------------------------------------------
-; $BF72 - sd_read_sector (params: sector en stack, buf ptr en AX)
-; Wrapper: lee sector de $F0-$F3, buf de $F4-$F5
+; $BF72 - sd_read_sector: sector en $F0-$F3, buf en $F4-$F5
 sd_read_sector_entry:
-    JMP _sd_read_sector_wrap
+    JMP sd_read_sector_wrap
 
-; $BF75 - sd_write_sector (params: sector en stack, buf ptr en AX)
-; Wrapper: lee sector de $F0-$F3, buf de $F4-$F5
+; $BF75 - sd_write_sector: sector en $F0-$F3, buf en $F4-$F5
 sd_write_sector_entry:
-    JMP _sd_write_sector_wrap
+    JMP sd_write_sector_wrap
 
 ; $BF78 - sd_is_ready (retorna status en A)
 sd_is_ready_entry:
@@ -308,12 +368,16 @@ sd_get_type_entry:
 ; ---------------------------------------------------------------------------
 ; $BF7E - mfs_load_file: Carga archivo SD a memoria
 ;         Input: $F4-$F5 = nombre archivo, $F6-$F7 = dirección destino
+;         (ignorada si el archivo tiene cabecera X65; 0 = $0800)
+;         Output: A/X = punto de entrada, 0 si falla
 ;         Requiere: SD montada
 mfs_load_file_entry:
     JMP mfs_load_file_wrap
 
 ; $BF81 - mfs_load_run: Carga archivo SD y lo ejecuta
 ;         Input: $F4-$F5 = nombre archivo, $F6-$F7 = dirección destino
+;         Salta a la entrada de la cabecera X65 (o a la dirección de
+;         carga); si la carga falla retorna sin ejecutar
 ;         Requiere: SD montada
 mfs_load_run_entry:
     JMP mfs_load_run_wrap
@@ -324,14 +388,275 @@ mfs_load_run_entry:
 ; $BF84 - Magic number y versión
 romapi_magic:
     .byte "ROMAPI"      ; Magic: "ROMAPI"
-        .byte $24           ; VersiÃ³n (major<<4 | minor)
+        .byte $3E           ; VersiÃ³n (major<<4 | minor)
+
+; $BF8B - Bitmap de funciones (ROMAPI_FEAT_*), little-endian
+romapi_features:
+    .word ROMAPI_FEATURES
+
+; $BF8D - Segundo bitmap (ROMAPI_FEAT2_*), válido con versión >= $3C
+romapi_features2:
+    .byte ROMAPI_FEATURES2
+
+; Padding hasta $BF90: inicio de la tabla extendida
+.res $90 - (* - _romapi_start), $EA
+
+; ---------------------------------------------------------------------------
+; MICROFS - Listado del índice y tamaño en 32 bits (Base: $BF90)
+; ---------------------------------------------------------------------------
+; $BF90 - mfs_list_ext: entrada del índice de directorio del monitor
+;         Input: $F4-$F5 = index (0..n-1, sin huecos), $F6-$F7 = info ptr
+;         info: name[13] + size (uint32) = 17 bytes; el tamaño viene del
+;         campo de 16 bits de MicroFS
+;         Output: A = MFS_OK, MFS_ERR_NOTFOUND al pasar del final o
+;         MON_FS_PARTIAL ($10) si hay archivos fuera del índice
+mfs_list_ext_entry:
+    JMP _mon_fs_list_zp
+
+; $BF93 - mfs_get_size32: tamaño del archivo abierto (uint32 en sreg:A:X)
+mfs_get_size32_entry:
+    JMP _mon_fs_get_size32
+
+; ---------------------------------------------------------------------------
+; RANURAS DE EXTENSIÓN (Base: $BF96)
+; ---------------------------------------------------------------------------
+; Saltan por _mon_ext_vec: las atiende un módulo residente (modules/)
+; y, sin él, retornan $FF (A/X/sreg). ext_features ($BE6C) dice cuáles
+; están servidas
+; $BF96/$BF99 - mfs_seek/mfs_tell sobre el stream de $BF9F (MicroFS
+;         solo lee en secuencia)
+mfs_seek_entry:
+    JMP (_mon_ext_vec + X_STREAM * 2 + 8)
+
+mfs_tell_entry:
+    JMP (_mon_ext_vec + X_STREAM * 2 + 10)
+
+; $BF9C - spi_transfer_block
+spi_transfer_block_entry:
+    JMP (_mon_ext_vec + X_SPIBLK * 2)
+
+; $BF9F-$BFA8 - mfs_stream_open/getc/poll/close
+mfs_stream_open_entry:
+    JMP (_mon_ext_vec + X_STREAM * 2)
+
+mfs_stream_getc_entry:
+    JMP (_mon_ext_vec + X_STREAM * 2 + 2)
+
+mfs_stream_poll_entry:
+    JMP (_mon_ext_vec + X_STREAM * 2 + 4)
+
+mfs_stream_close_entry:
+    JMP (_mon_ext_vec + X_STREAM * 2 + 6)
+
+; Wrappers con ZP fijo (ver más abajo) en el resto de la página
+; sd_read_sector_wrap: sector en $F0-$F3, buf en $F4-$F5
+sd_read_sector_wrap:
+    lda     $F0
+    ldx     $F1
+    jsr     pushax
+    lda     $F2
+    ldx     $F3
+    jsr     pushax
+    lda     $F4
+    ldx     $F5
+    jmp     _sd_read_sector
+
+; sd_write_sector_wrap: sector en $F0-$F3, buf en $F4-$F5
+sd_write_sector_wrap:
+    lda     $F0
+    ldx     $F1
+    jsr     pushax
+    lda     $F2
+    ldx     $F3
+    jsr     pushax
+    lda     $F4
+    ldx     $F5
+    jmp     _sd_write_sector
+
+; mfs_write_wrap: buf en $F4-$F5 (stack), len en $F6-$F7 (AX)
+mfs_write_wrap:
+    lda     $F4
+    ldx     $F5
+    jsr     pushax      ; push buf (1er param) al stack
+    lda     $F6
+    ldx     $F7
+    jmp     _mfs_write  ; len (2do param) en AX
+
+; mfs_create_wrap: name ptr en $F4-$F5 (stack), size en $F6-$F7 (AX)
+mfs_create_wrap:
+    lda     $F4
+    ldx     $F5
+    jsr     pushax      ; push name (1er param) al stack
+    lda     $F6
+    ldx     $F7
+    jmp     _mon_fs_create ; size (2do param) en AX
+
+; ===========================================================================
+; SEGMENTO ROMAPI3 - Jump Table v3 en $BE00
+; ===========================================================================
+; Convención única: parámetros en ZP $F0-$F7 (y A), resultado en A/X.
+; Ninguna entrada espera parámetros en el stack de CC65; las que pasan
+; por C usan por dentro el del monitor, como los wrappers de $BF00.
+.segment "ROMAPI3"
+
+; $BE00 - mfs_read: $F0-$F1 = buf, $F2-$F3 = len. Retorna A/X = leídos
+;         Función C, igual que $BF27
+mfs_read3_entry:
+    JMP _mfs_read_ext
+
+; $BE03 - mfs_list: $F4-$F5 = index, $F6-$F7 = info (17 bytes)
+;         Función C: lee del índice en RAM del monitor, igual que $BF90
+mfs_list3_entry:
+    JMP _mon_fs_list_zp
+
+; $BE06 - mfs_open: $F4-$F5 = nombre
+mfs_open3_entry:
+    JMP mfs_open_wrap
+
+; $BE09 - mfs_seek del stream (ranura de extensión, como $BF96)
+mfs_seek3_entry:
+    JMP (_mon_ext_vec + X_STREAM * 2 + 8)
+
+; $BE0C - sd_read_sector: $F0-$F3 = sector, $F4-$F5 = buf
+;         Mismo wrapper que $BF72: pasa los parámetros al stack de
+;         CC65 del monitor (pushax) y llama a la librería SD
+sd_read_sector3_entry:
+    JMP sd_read_sector_wrap
+
+; $BE0F - sd_write_sector: $F0-$F3 = sector, $F4-$F5 = buf
+sd_write_sector3_entry:
+    JMP sd_write_sector_wrap
+
+; $BE12-$BE24 - ranuras de extensión: spi_transfer_block,
+;         mem_copy/fill/compare, mul8x8, mul16x16, div32x16
+spi_transfer_block3_entry:
+    JMP (_mon_ext_vec + X_SPIBLK * 2)
+
+mem_copy_entry:
+    JMP (_mon_ext_vec + X_MEM * 2)
+
+mem_fill_entry:
+    JMP (_mon_ext_vec + X_MEM * 2 + 2)
+
+mem_compare_entry:
+    JMP (_mon_ext_vec + X_MEM * 2 + 4)
+
+mul8x8_entry:
+    JMP (_mon_ext_vec + X_MULDIV * 2)
+
+mul16x16_entry:
+    JMP (_mon_ext_vec + X_MULDIV * 2 + 2)
+
+div32x16_entry:
+    JMP (_mon_ext_vec + X_MULDIV * 2 + 4)
+
+; $BE27 - bin_to_bcd: $F0-$F3 -> 5 bytes BCD (little-endian) en ($F4)
+bin_to_bcd_entry:
+    JMP _bin_to_bcd
+
+; $BE2A - u16toa: $F0-$F1 -> decimal en ($F4), A = longitud
+u16toa_entry:
+    JMP _u16toa
+
+; $BE2D - u32toa: $F0-$F3 -> decimal en ($F4), A = longitud
+u32toa_entry:
+    JMP _u32toa
+
+; $BE30 - u16tohex: $F0-$F1 -> "HHHH" en ($F4), A = 4
+u16tohex_entry:
+    JMP _u16tohex
+
+; $BE33 - cmd_register: $F0-$F1 = nodo mon_ucmd_t (0 = borrar la lista)
+cmd_register_entry:
+    JMP cmd_register_wrap
+
+; $BE36-$BE63 - ranuras de extensión: lz_unpack, arena, pools, tareas,
+;         alarmas, SPI full duplex e I2C en bloque
+lz_unpack_entry:
+    JMP (_mon_ext_vec + X_LZ * 2)
+
+arena_init_entry:
+    JMP (_mon_ext_vec + X_ALLOC * 2)
+
+arena_alloc_entry:
+    JMP (_mon_ext_vec + X_ALLOC * 2 + 2)
+
+arena_mark_entry:
+    JMP (_mon_ext_vec + X_ALLOC * 2 + 4)
+
+arena_release_entry:
+    JMP (_mon_ext_vec + X_ALLOC * 2 + 6)
+
+pool_init_entry:
+    JMP (_mon_ext_vec + X_ALLOC * 2 + 8)
+
+pool_alloc_entry:
+    JMP (_mon_ext_vec + X_ALLOC * 2 + 10)
+
+pool_free_entry:
+    JMP (_mon_ext_vec + X_ALLOC * 2 + 12)
+
+task_add_entry:
+    JMP (_mon_ext_vec + X_TASK * 2)
+
+task_remove_entry:
+    JMP (_mon_ext_vec + X_TASK * 2 + 2)
+
+; También la espera de teclas del monitor (mon_read_line): sin módulo
+; SCHED es romapi_nosys
+task_yield_entry:
+_mon_idle:
+    JMP (_mon_ext_vec + X_TASK * 2 + 4)
+
+alarm_set_entry:
+    JMP (_mon_ext_vec + X_ALARM * 2)
+
+alarm_cancel_entry:
+    JMP (_mon_ext_vec + X_ALARM * 2 + 2)
+
+spi_xfer_buf_entry:
+    JMP (_mon_ext_vec + X_BUSBLK * 2)
+
+i2c_write_buf_entry:
+    JMP (_mon_ext_vec + X_BUSBLK * 2 + 2)
+
+i2c_read_buf_entry:
+    JMP (_mon_ext_vec + X_BUSBLK * 2 + 4)
+
+; $BE66 - stats_read: A/X = bloque de contadores (mon_stats_t). El
+;         que llama lo copia y, si quiere, lo pone a cero
+stats_read_entry:
+    JMP stats_read
+
+; $BE69 - ext_register: $F0-$F1 = descriptor de módulo
+;         { first, count, vec[count] }. Retorna A = 0, o $FF si el
+;         tramo de ranuras no existe. $F0-$F1 = 0: todas a $FF
+ext_register_entry:
+    JMP ext_register
+
+; $BE6C - ext_features: A/X = bitmap de $BF8B más los bits de las
+;         ranuras servidas; sreg = el de $BF8D más los suyos
+ext_features_entry:
+    JMP ext_features
+
+; $BE6F - mfs_write: $F4-$F5 = buf, $F6-$F7 = len (v3.14)
+;         Mismo wrapper que $BF3F. Retorna A/X = escritos
+mfs_write3_entry:
+    JMP mfs_write_wrap
+
+; $BE72 - mfs_create: $F4-$F5 = nombre, $F6-$F7 = tamaño (v3.14)
+;         Mismo wrapper que $BF3C
+mfs_create3_entry:
+    JMP mfs_create_wrap
 
 ; ---------------------------------------------------------------------------
 ; WRAPPERS CON ZP FIJO - Para programas externos
 ; ---------------------------------------------------------------------------
-; Estos wrappers leen parÃ¡metros de Zero Page fijo y los pasan al
+; Estos wrappers leen parámetros de Zero Page fijo y los pasan al
 ; stack de CC65 del monitor, permitiendo que programas externos
 ; llamen funciones que usan stack sin conflictos de sp.
+; No necesitan dirección fija: ocupan el resto de las páginas de
+; las tablas ($BE75-$BEFF y $BFAB-$BFF9), que si no quedarían vacías.
 
 ; mfs_read_wrap: buf en $F0-$F1 (stack), len en $F2-$F3 (AX)
 mfs_read_wrap:
@@ -342,23 +667,28 @@ mfs_read_wrap:
     ldx     $F3
     jmp     _mfs_read   ; len (2do param) en AX
 
-; mfs_list_wrap: llama a _mfs_list con buffer en BSS.
-.segment "CODE"
-.import _mfs_list
+; mfs_list_wrap: index en $F4 (stack), info ptr en $F5-$F6
+; MicroFS escribe su fileinfo completo en un buffer en BSS y al
+; llamador se le copian solo los 15 bytes de rom_mfs_fileinfo_t
+.segment "BSS"
+mfs_list_tmp:
+    .res    16
+.segment "ROMAPI3"
+
 mfs_list_wrap:
     lda     $F4
-    jsr     pusha
-    lda     #<(_mfs_list_tmp)
-    ldx     #>(_mfs_list_tmp)
+    jsr     pusha       ; push index (1er param) al stack
+    lda     #<mfs_list_tmp
+    ldx     #>mfs_list_tmp
     jsr     _mfs_list
     pha
     lda     $F5
     sta     ptr2
     lda     $F6
     sta     ptr2+1
-    lda     #<(_mfs_list_tmp)
+    lda     #<mfs_list_tmp
     sta     ptr1
-    lda     #>(_mfs_list_tmp)
+    lda     #>mfs_list_tmp
     sta     ptr1+1
     ldy     #14
 :   lda     (ptr1),y
@@ -367,66 +697,36 @@ mfs_list_wrap:
     bpl     :-
     pla
     rts
-.segment "ROMAPI"
 
-; mfs_write_wrap: buf en $F4-$F5 (stack), len en $F6-$F7 (AX)
-mfs_write_wrap:
-    lda     $F4
-    ldx     $F5
-    jsr     pushax      ; push buf (1er param) al stack
-    lda     $F6
-    ldx     $F7
-    jmp     _mfs_write  ; len (2do param) en AX
-
-; sd_read_sector_wrap: sector en $F0-$F3, buf en $F4-$F5
-_sd_read_sector_wrap:
-    lda     $F0
-    ldx     $F1
-    jsr     pushax
-    lda     $F2
-    ldx     $F3
-    jsr     pushax
-    lda     $F4
-    ldx     $F5
-    jmp     _sd_read_sector
-
-; sd_write_sector_wrap: sector en $F0-$F3, buf en $F4-$F5
-_sd_write_sector_wrap:
+; cmd_register_wrap: nodo en $F0-$F1 -> fastcall AX
+cmd_register_wrap:
     lda     $F0
     ldx     $F1
-    jsr     pushax
-    lda     $F2
-    ldx     $F3
-    jsr     pushax
-    lda     $F4
-    ldx     $F5
-    jmp     _sd_write_sector
+    jmp     _mon_cmd_register
+
+; romapi_nosys: entrada reservada. A/X/sreg = $FF (error, o -1 en 32 bits)
+romapi_nosys:
+    lda     #$FF
+    tax
+    sta     sreg
+    sta     sreg+1
+    rts
 
-; mfs_open_wrap: name ptr en $F4-$F5
+; mfs_open_wrap: name ptr en $F4-$F5 (resuelve en el índice)
 mfs_open_wrap:
     lda     $F4
     ldx     $F5
-    jmp     _mfs_open
+    jmp     _mon_fs_open
 
 ; mfs_delete_wrap: name ptr en $F4-$F5
 mfs_delete_wrap:
     lda     $F4
     ldx     $F5
-    jmp     _mfs_delete
-
-; mfs_create_wrap: name ptr en $F4-$F5 (stack), size en $F6-$F7 (AX)
-mfs_create_wrap:
-    lda     $F4
-    ldx     $F5
-    jsr     pushax      ; push name (1er param) al stack
-    lda     $F6
-    ldx     $F7
-    jmp     _mfs_create ; size (2do param) en AX
+    jmp     _mon_fs_delete
 
 ; ===========================================================================
 ; WRAPPERS DE CARGA Y EJECUCIÓN
 ; ===========================================================================
-.segment "CODE"
 
 ; mfs_load_file_wrap: Carga archivo SD a memoria
 ; name en $F4-$F5, addr en $F6-$F7
@@ -453,10 +753,163 @@ mfs_load_run_wrap:
     ldx     $F7
     jsr     _mon_sd_load
 
-    ; Ejecutar en la dirección cargada
-    lda     $F6
-    ldx     $F7
-    jmp     _mon_execute
+    ; Ejecutar en la entrada retornada (0 = error)
+    cpx     #0
+    bne     :+
+    cmp     #0
+    beq     @fail
+:   jmp     _mon_execute
+@fail:
+    rts
 
-.segment "ROMAPI"
 ; ===========================================================================
+; RANURAS DE EXTENSIÓN
+; ===========================================================================
+; Vector por ranura en RAM, a $0200 (config/fpga.cfg): índices pares y
+; sin cruzar página, así JMP (ind) nunca cae en el fallo de $xxFF.
+; Un vector apunta a romapi_nosys (ROM) o al código de un módulo
+; (RAM): el bit 7 del byte alto distingue una ranura servida.
+.segment "EXTVEC"
+_mon_ext_vec:
+    .res    X_COUNT * 2
+
+.segment "BSS"
+ext_acc:
+    .res    3                   ; bitmaps de ext_features
+_mon_stats:
+    .res    10                  ; mon_stats_t (libs/monitor/monitor.h)
+
+.segment "CODE"
+
+; ext_register: $F0-$F1 = { first, count, vec[count] }
+ext_register:
+    lda     $F0
+    ora     $F1
+    beq     _mon_ext_reset
+    ldy     #1
+    lda     ($F0),y             ; count
+    beq     @bad
+    dey
+    clc
+    adc     ($F0),y             ; first + count
+    bcs     @bad
+    cmp     #X_COUNT + 1
+    bcs     @bad
+    asl     a
+    sta     tmp1                ; fin en _mon_ext_vec
+    lda     ($F0),y
+    asl     a
+    tax
+    ldy     #2
+    php
+    sei                         ; una IRQ no debe ver medio vector
+@copy:
+    lda     ($F0),y
+    sta     _mon_ext_vec,x
+    iny
+    inx
+    cpx     tmp1
+    bne     @copy
+    plp
+    lda     #0
+    tax
+    rts
+@bad:
+    lda     #$FF
+    tax
+    rts
+
+; void mon_ext_reset(void): todas las ranuras a romapi_nosys
+_mon_ext_reset:
+    ldx     #X_COUNT * 2 - 2
+:   jsr     ext_nosys
+    dex
+    dex
+    bpl     :-
+    lda     #0
+    tax
+    rts
+
+; void mon_ext_drop(uint8_t lo, uint8_t hi): las ranuras cuyo código
+; está en las páginas lo..hi (ambas incluidas) vuelven a romapi_nosys.
+; El monitor la llama al pisar o liberar un programa
+_mon_ext_drop:
+    sta     tmp2                ; hi
+    jsr     popa
+    sta     tmp1                ; lo
+    ldx     #X_COUNT * 2 - 2
+@loop:
+    lda     _mon_ext_vec+1,x
+    cmp     tmp1
+    bcc     @next
+    cmp     tmp2
+    beq     @drop
+    bcs     @next
+@drop:
+    jsr     ext_nosys
+@next:
+    dex
+    dex
+    bpl     @loop
+    rts
+
+; Ranura X (índice par) -> romapi_nosys, sin IRQ a medias
+ext_nosys:
+    php
+    sei
+    lda     #<romapi_nosys
+    sta     _mon_ext_vec,x
+    lda     #>romapi_nosys
+    sta     _mon_ext_vec+1,x
+    plp
+    rts
+
+; stats_read: el bloque está en el BSS, a cero en cada arranque
+stats_read:
+    lda     #<_mon_stats
+    ldx     #>_mon_stats
+    rts
+
+; ext_features: bitmaps estáticos más los de las ranuras servidas
+ext_features:
+    lda     #<ROMAPI_FEATURES
+    sta     ext_acc
+    lda     #>ROMAPI_FEATURES
+    sta     ext_acc+1
+    lda     #ROMAPI_FEATURES2
+    sta     ext_acc+2
+    ldy     #EXT_FEAT_N * 3 - 3
+@loop:
+    ldx     ext_feat_tab,y
+    lda     _mon_ext_vec+1,x
+    bmi     @next               ; romapi_nosys
+    ldx     ext_feat_tab+1,y
+    lda     ext_feat_tab+2,y
+    ora     ext_acc,x
+    sta     ext_acc,x
+@next:
+    dey
+    dey
+    dey
+    bpl     @loop
+    lda     ext_acc+2
+    sta     sreg
+    lda     #0
+    sta     sreg+1
+    lda     ext_acc
+    ldx     ext_acc+1
+    rts
+
+; Bit que aporta cada tramo: ranura * 2, byte (0-1: $BF8B, 2: $BF8D), máscara
+ext_feat_tab:
+    .byte   X_SPIBLK * 2,       0, <ROMAPI_FEAT_SPIBLK
+    .byte   X_BUSBLK * 2 + 2,   1, >ROMAPI_FEAT_BUSBLK
+    .byte   X_STREAM * 2,       0, <ROMAPI_FEAT_STREAM
+    .byte   X_STREAM * 2 + 8,   0, <ROMAPI_FEAT_SEEK
+    .byte   X_MEM * 2,          0, <ROMAPI_FEAT_MEM
+    .byte   X_MULDIV * 2,       2, ROMAPI_FEAT2_MULDIV
+    .byte   X_LZ * 2,           1, >ROMAPI_FEAT_LZ
+    .byte   X_ALLOC * 2,        1, >ROMAPI_FEAT_ALLOC
+    .byte   X_TASK * 2,         1, >ROMAPI_FEAT_SCHED
+    .byte   X_ALARM * 2,        1, >ROMAPI_FEAT_ALARM
+EXT_FEAT_N = (* - ext_feat_tab) / 3
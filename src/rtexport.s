@@ -0,0 +1,199 @@
+;; ===========================================================================
+;; RTEXPORT.S - Runtime de CC65 exportado desde la ROM
+;; ===========================================================================
+;;
+;; Tabla de saltos fija en $BD00 con los helpers del runtime que genera
+;; CC65 (stack, variables locales, punteros, comparaciones...). Los
+;; programas de usuario enlazan include/romrt.s en lugar de none.lib y
+;; llaman a estas entradas: el runtime no ocupa RAM de usuario.
+;;
+;; Cada .import de aquí mete su módulo de none.lib en la ROM aunque el
+;; monitor no lo use, así que la tabla se limita a los helpers básicos.
+;; Multiplicación/división, desplazamientos con signo o de cuenta
+;; variable y comparaciones con signo a bool no están (ver romrt.s).
+;;
+;; El orden de la tabla es el ABI: agregar siempre al final y repetir
+;; la entrada en include/romrt.s (dirección = $BD00 + 3 * índice). La
+;; tabla no debe pasar de $BDFF (ROMAPI3 empieza en $BE00).
+;;
+;; Los helpers usan las variables ZP del monitor (sp, sreg, ptrN,
+;; tmpN...). El programa comparte el stack de CC65 del monitor, así
+;; que las llamadas a la ROM API con stack tampoco entran en conflicto.
+;; ===========================================================================
+
+; Helpers del runtime (none.lib)
+.import pusha, pusha0, pushax, push0, push1, popa, popax, incsp1
+.import incsp2, incsp3, incsp4, incsp5, incsp6, incsp7, incsp8, decsp1
+.import decsp2, decsp3, decsp4, decsp5, decsp6, decsp7, decsp8, addysp
+.import subysp, ldax0sp, ldaxysp, staxysp, stax0sp, pushwysp, ldaxi, ldaidx
+.import ldauidx, tosaddax, tossubax, tosandax, tosorax, tosxorax, aslax1, aslax2
+.import aslax3, aslax4, shlax1, shlax2, shlax3, shlax4, shrax1, shrax2
+.import shrax3, shrax4, booleq, boolne, boollt, boolle, boolgt, boolge
+.import boolult, boolule, boolugt, booluge, toseqax, tosneax, tosultax, tosuleax
+.import tosugtax, tosugeax, tosicmp, negax, complax, bnegax, incax1, decax1
+.import callax
+
+; Variables ZP del runtime: include/romrt.s las fija en estas direcciones
+.importzp sp, sreg, regsave, ptr1, ptr2, ptr3, ptr4, tmp1, tmp2, tmp3, tmp4, regbank
+
+.assert sp = $0E, error, "romrt: sp cambio de ZP, actualizar include/romrt.s"
+.assert sreg = $10, error, "romrt: sreg cambio de ZP, actualizar include/romrt.s"
+.assert regsave = $12, error, "romrt: regsave cambio de ZP, actualizar include/romrt.s"
+.assert ptr1 = $16, error, "romrt: ptr1 cambio de ZP, actualizar include/romrt.s"
+.assert ptr2 = $18, error, "romrt: ptr2 cambio de ZP, actualizar include/romrt.s"
+.assert ptr3 = $1A, error, "romrt: ptr3 cambio de ZP, actualizar include/romrt.s"
+.assert ptr4 = $1C, error, "romrt: ptr4 cambio de ZP, actualizar include/romrt.s"
+.assert tmp1 = $1E, error, "romrt: tmp1 cambio de ZP, actualizar include/romrt.s"
+.assert tmp2 = $1F, error, "romrt: tmp2 cambio de ZP, actualizar include/romrt.s"
+.assert tmp3 = $20, error, "romrt: tmp3 cambio de ZP, actualizar include/romrt.s"
+.assert tmp4 = $21, error, "romrt: tmp4 cambio de ZP, actualizar include/romrt.s"
+.assert regbank = $22, error, "romrt: regbank cambio de ZP, actualizar include/romrt.s"
+
+.segment "RTJUMP"
+
+; $BD00
+    JMP pusha
+; $BD03
+    JMP pusha0
+; $BD06
+    JMP pushax
+; $BD09
+    JMP push0
+; $BD0C
+    JMP push1
+; $BD0F
+    JMP popa
+; $BD12
+    JMP popax
+; $BD15
+    JMP incsp1
+; $BD18
+    JMP incsp2
+; $BD1B
+    JMP incsp3
+; $BD1E
+    JMP incsp4
+; $BD21
+    JMP incsp5
+; $BD24
+    JMP incsp6
+; $BD27
+    JMP incsp7
+; $BD2A
+    JMP incsp8
+; $BD2D
+    JMP decsp1
+; $BD30
+    JMP decsp2
+; $BD33
+    JMP decsp3
+; $BD36
+    JMP decsp4
+; $BD39
+    JMP decsp5
+; $BD3C
+    JMP decsp6
+; $BD3F
+    JMP decsp7
+; $BD42
+    JMP decsp8
+; $BD45
+    JMP addysp
+; $BD48
+    JMP subysp
+; $BD4B
+    JMP ldax0sp
+; $BD4E
+    JMP ldaxysp
+; $BD51
+    JMP staxysp
+; $BD54
+    JMP stax0sp
+; $BD57
+    JMP pushwysp
+; $BD5A
+    JMP ldaxi
+; $BD5D
+    JMP ldaidx
+; $BD60
+    JMP ldauidx
+; $BD63
+    JMP tosaddax
+; $BD66
+    JMP tossubax
+; $BD69
+    JMP tosandax
+; $BD6C
+    JMP tosorax
+; $BD6F
+    JMP tosxorax
+; $BD72
+    JMP aslax1
+; $BD75
+    JMP aslax2
+; $BD78
+    JMP aslax3
+; $BD7B
+    JMP aslax4
+; $BD7E
+    JMP shlax1
+; $BD81
+    JMP shlax2
+; $BD84
+    JMP shlax3
+; $BD87
+    JMP shlax4
+; $BD8A
+    JMP shrax1
+; $BD8D
+    JMP shrax2
+; $BD90
+    JMP shrax3
+; $BD93
+    JMP shrax4
+; $BD96
+    JMP booleq
+; $BD99
+    JMP boolne
+; $BD9C
+    JMP boollt
+; $BD9F
+    JMP boolle
+; $BDA2
+    JMP boolgt
+; $BDA5
+    JMP boolge
+; $BDA8
+    JMP boolult
+; $BDAB
+    JMP boolule
+; $BDAE
+    JMP boolugt
+; $BDB1
+    JMP booluge
+; $BDB4
+    JMP toseqax
+; $BDB7
+    JMP tosneax
+; $BDBA
+    JMP tosultax
+; $BDBD
+    JMP tosuleax
+; $BDC0
+    JMP tosugtax
+; $BDC3
+    JMP tosugeax
+; $BDC6
+    JMP tosicmp
+; $BDC9
+    JMP negax
+; $BDCC
+    JMP complax
+; $BDCF
+    JMP bnegax
+; $BDD2
+    JMP incax1
+; $BDD5
+    JMP decax1
+; $BDD8
+    JMP callax
@@ -27,9 +27,10 @@ _init:
     txs
     
     ; Inicializar stack pointer de CC65 (software stack)
-    lda #<$3FFF
+    ; $3FF2-$3FFF queda para el flag y el registro del auto-boot
+    lda #<$3FF2
     sta sp
-    lda #>$3FFF
+    lda #>$3FF2
     sta sp+1
     
     ; Copiar DATA de ROM a RAM
@@ -48,15 +49,12 @@ _init:
 ; ============================================
 ; copydata - Copia DATA de ROM a RAM
 ; ============================================
+; Por páginas: X cuenta páginas completas e Y recorre cada una
+; (desenrollado x4); luego los bytes sueltos. Sin contador de 16 bits
+; por byte.
 .segment "CODE"
 
 copydata:
-    ; Verificar si hay datos que copiar
-    lda #<__DATA_SIZE__
-    ora #>__DATA_SIZE__
-    beq @done           ; Si tamaño es 0, salir
-    
-    ; Inicializar punteros
     lda #<__DATA_LOAD__
     sta ptr1
     lda #>__DATA_LOAD__
@@ -67,37 +65,35 @@ copydata:
     lda #>__DATA_RUN__
     sta ptr2+1
     
-    ; Contador de bytes
-    lda #<__DATA_SIZE__
-    sta count
-    lda #>__DATA_SIZE__
-    sta count+1
-    
     ldy #0
-@loop:
+    ldx #>__DATA_SIZE__         ; Páginas completas
+    beq @tail
+@page:
+    lda (ptr1),y
+    sta (ptr2),y
+    iny
     lda (ptr1),y
     sta (ptr2),y
-    
-    ; Incrementar punteros
     iny
-    bne @check
+    lda (ptr1),y
+    sta (ptr2),y
+    iny
+    lda (ptr1),y
+    sta (ptr2),y
+    iny
+    bne @page
     inc ptr1+1
     inc ptr2+1
+    dex
+    bne @page
     
-@check:
-    ; Decrementar contador
-    lda count
-    bne @dec_lo
-    lda count+1
+@tail:
+    cpy #<__DATA_SIZE__         ; Y = 0 al entrar
     beq @done
-    dec count+1
-@dec_lo:
-    dec count
-    
-    ; Verificar si terminamos
-    lda count
-    ora count+1
-    bne @loop
+    lda (ptr1),y
+    sta (ptr2),y
+    iny
+    bne @tail                   ; Siempre (Y < 256)
     
 @done:
     rts
@@ -106,44 +102,35 @@ copydata:
 ; zerobss - Inicializa BSS a ceros
 ; ============================================
 zerobss:
-    ; Verificar si hay BSS
-    lda #<__BSS_SIZE__
-    ora #>__BSS_SIZE__
-    beq @done
-    
     lda #<__BSS_RUN__
     sta ptr1
     lda #>__BSS_RUN__
     sta ptr1+1
     
-    lda #<__BSS_SIZE__
-    sta count
-    lda #>__BSS_SIZE__
-    sta count+1
-    
-    ldy #0
     lda #0
-@loop:
+    tay
+    ldx #>__BSS_SIZE__          ; Páginas completas
+    beq @tail
+@page:
+    sta (ptr1),y
+    iny
     sta (ptr1),y
-    
     iny
-    bne @check
+    sta (ptr1),y
+    iny
+    sta (ptr1),y
+    iny
+    bne @page
     inc ptr1+1
+    dex
+    bne @page
     
-@check:
-    ; Decrementar contador
-    ldx count
-    bne @dec_lo
-    ldx count+1
+@tail:
+    cpy #<__BSS_SIZE__
     beq @done
-    dec count+1
-@dec_lo:
-    dec count
-    
-    ldx count
-    bne @loop
-    ldx count+1
-    bne @loop
+    sta (ptr1),y
+    iny
+    bne @tail
     
 @done:
     rts
@@ -154,4 +141,3 @@ zerobss:
 .segment "ZEROPAGE"
 ptr1:   .res 2
 ptr2:   .res 2
-count:  .res 2
@@ -1,6 +1,7 @@
 // xmodem.c - XMODEM para 6502
 #include "xmodem.h"
 #include "../libs/uart-6502-cc65/uart.h"
+#include "../libs/monitor/monitor.h"
 
 #define SOH  0x01
 #define EOT  0x04
@@ -54,6 +55,7 @@ process_block:
     } else if (blk_num == (unsigned char)(blk_expected - 1)) {
         uart_putc(ACK);
     } else {
+        ++mon_stats.xm_nak;
         uart_putc(NAK);
     }
     
@@ -68,5 +70,6 @@ process_block:
     }
     
     // Timeout esperando siguiente bloque - asumir fin
+    ++mon_stats.xm_timeout;
     return (int)bytes_received;
 }